@@ -0,0 +1,44 @@
+#include <benchmark/benchmark.h>
+
+#include <vector>
+
+#include "dealer.h"
+#include "default_operation.h"
+#include "player.h"
+#include "poker.h"
+#include "rng.h"
+#include "test_util.h"
+
+static void BM_PokerGetPokerValue(benchmark::State& state) {
+  std::vector<Poker> cards = deckCards(1);
+  for (auto _ : state) {
+    int total = 0;
+    for (Poker poker : cards) total += Poker::getPokerValue(poker);
+    benchmark::DoNotOptimize(total);
+  }
+  state.SetItemsProcessed(state.iterations() * cards.size());
+}
+BENCHMARK(BM_PokerGetPokerValue);
+
+// 玩家手上 state.range(0) 張牌時算一次點數
+static void BM_PlayerGetPoint(benchmark::State& state) {
+  DefaultOperation operation;
+  Player player("bench", &operation);
+  std::vector<Poker> cards = deckCards(1);
+  for (int i = 0; i < state.range(0); i++) player.addPoker(cards[i * 5]);
+
+  for (auto _ : state) benchmark::DoNotOptimize(player.getPoint());
+}
+BENCHMARK(BM_PlayerGetPoint)->Arg(2)->Arg(5);
+
+// 洗 state.range(0) 副牌
+static void BM_DealerShuffle(benchmark::State& state) {
+  std::vector<Poker> cardPool = deckCards(static_cast<int>(state.range(0)));
+  Xoshiro256 rng(2024);
+  for (auto _ : state) {
+    Dealer::shuffle(cardPool, rng);
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed(state.iterations() * cardPool.size());
+}
+BENCHMARK(BM_DealerShuffle)->Arg(1)->Arg(4)->Arg(8);
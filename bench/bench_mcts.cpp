@@ -0,0 +1,82 @@
+#include <benchmark/benchmark.h>
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "mcts.h"
+#include "test_util.h"
+#include "thread_pool.h"
+
+namespace {
+
+// 硬 12 點對莊家 10，五個動作裡有四個可以選，樹會長得比較寬
+std::unique_ptr<mcts::MCTS> newSearch(int simulations, int playoutsPerLeaf,
+                                      ThreadPool& pool) {
+  HandState hand;
+  hand.addPoint(10);
+  hand.addPoint(2);
+  std::vector<Poker> dealerVisibleCards = {Poker(club, "K")};
+
+  mcts::Config config;
+  config.seed = 2024;
+  config.playoutsPerLeaf = playoutsPerLeaf;
+  config.pool = &pool;
+  config.threads = static_cast<int>(pool.size());
+  return std::make_unique<mcts::MCTS>(simulations, hand, fullShoe(4),
+                                      dealerVisibleCards, config);
+}
+
+}  // namespace
+
+// 一個葉節點模擬 state.range(0) 次，分給 state.range(1) 條線程
+static void BM_MCTSPlayout(benchmark::State& state) {
+  ThreadPool pool(state.range(1));
+  auto search = newSearch(1, static_cast<int>(state.range(0)), pool);
+  // 跑一次搜尋讓根節點展開，HIT 子節點才存在
+  search->run();
+  mcts::NodeId leaf = search->node(search->root).children[mcts::Action::HIT];
+
+  for (auto _ : state) benchmark::DoNotOptimize(search->playout(leaf));
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_MCTSPlayout)
+    ->Args({200, 1})
+    ->Args({2000, 1})
+    ->Args({2000, 4})
+    ->UseRealTime();
+
+// 選擇、展開、回傳的時間：每個葉節點只模擬一次，跑 batch 次迭代的完整搜尋，
+// 三個階段各自的時間從 SearchStats 讀出來，每次換一棵新的樹
+static void BM_MCTSSelectionExpansion(benchmark::State& state) {
+  ThreadPool pool(1);
+  const int batch = 1000;
+  std::uint64_t treeNs = 0;
+
+  for (auto _ : state) {
+    state.PauseTiming();
+    auto search = newSearch(batch, 1, pool);
+    state.ResumeTiming();
+
+    benchmark::DoNotOptimize(&search->run());
+
+    const SearchStats& stats = search->stats();
+    treeNs +=
+        stats.selectionNs + stats.expansionNs + stats.backpropagationNs;
+  }
+  state.SetItemsProcessed(state.iterations() * batch);
+  state.counters["tree_ns_per_iteration"] =
+      static_cast<double>(treeNs) / (state.iterations() * batch);
+}
+BENCHMARK(BM_MCTSSelectionExpansion);
+
+// 完整搜尋：state.range(0) 次迭代，每個葉節點模擬 200 次
+static void BM_MCTSRun(benchmark::State& state) {
+  ThreadPool pool(1);
+  for (auto _ : state) {
+    auto search = newSearch(static_cast<int>(state.range(0)), 200, pool);
+    benchmark::DoNotOptimize(&search->run());
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_MCTSRun)->Arg(100)->Arg(500)->Unit(benchmark::kMillisecond);
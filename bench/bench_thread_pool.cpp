@@ -0,0 +1,26 @@
+#include <benchmark/benchmark.h>
+
+#include <future>
+#include <vector>
+
+#include "thread_pool.h"
+
+// 一次丟 state.range(0) 個空任務再全部等完，量排程本身的開銷
+static void BM_ThreadPoolEnqueue(benchmark::State& state) {
+  ThreadPool pool(state.range(1));
+  std::vector<std::future<int>> futures;
+  futures.reserve(state.range(0));
+
+  for (auto _ : state) {
+    for (int i = 0; i < state.range(0); i++) {
+      futures.push_back(pool.enqueue([i] { return i; }));
+    }
+    for (auto& future : futures) benchmark::DoNotOptimize(future.get());
+    futures.clear();
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_ThreadPoolEnqueue)
+    ->Args({1000, 1})
+    ->Args({1000, 4})
+    ->UseRealTime();
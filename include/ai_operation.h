@@ -1,22 +1,69 @@
 #ifndef AI_OPERATION_H
 #define AI_OPERATION_H
 #include <memory>
+#include <ostream>
 
+#include "decision_cache.h"
 #include "mcts.h"
 #include "operation.h"
+#include "rng.h"
+#include "thread_pool.h"
 class AIOperation : public Operation {
  public:
-  std::map<std::string, bool> doubleOrSurrender(std::vector<Poker>,
-                                                std::vector<Poker>,
-                                                std::vector<Poker>) override;
-  bool hit(std::vector<Poker>, std::vector<Poker>, std::vector<Poker>) override;
-  bool insurance(std::vector<Poker>, std::vector<Poker>,
-                 std::vector<Poker>) override;
-  int stake(int, std::vector<Poker>, std::vector<Poker>) override;
+  OpeningDecision doubleOrSurrender(const DecisionContext&) override;
+  bool hit(const DecisionContext&) override;
+  bool insurance(const DecisionContext&) override;
+  int stake(const DecisionContext&) override;
 
   AIOperation();
+  // 固定主種子，讓每次搜尋的亂數串流都可以重現
+  explicit AIOperation(std::uint64_t seed);
+  // 搜尋改用指定的執行緒池，預設是 ThreadPool::shared()；
+  // searchThreads 為 0 表示用整個執行緒池。cache 不是 nullptr 時，
+  // 搜尋過的狀態會存起來給之後同樣的狀態直接用；因為時間限制
+  // 提早停下的搜尋不會存
+  AIOperation(std::uint64_t seed, ThreadPool& pool, int searchThreads = 0,
+              DecisionCache* cache = nullptr);
+
+  // 每次決策的搜尋預算，預設是 5000 次迭代，並在 95% 信心水準下
+  // 提早停止；設定時間限制時，
+  // 時間到了就用目前最好的動作
+  void setSearchLimits(const mcts::SearchLimits& limits) { _limits = limits; }
+  const mcts::SearchLimits& searchLimits() const { return _limits; }
+
+  // 每次搜尋完把 SearchStats 以一行 JSON 寫到 log，nullptr 表示不寫
+  void setStatsLog(std::ostream* log) { _statsLog = log; }
+
+  // 最近一次實際搜尋的統計，命中快取或沿用同一棵樹時不會更新
+  const SearchStats& lastSearchStats() const { return _lastStats; }
 
  private:
+  Xoshiro256 _seeder;
+
+  ThreadPool* _pool;
+  int _searchThreads;
+
+  DecisionCache* _cache;
+  // 這一手有沒有買保險，是快取 key 的一部分
+  bool _insured;
+
+  // 同一手牌的所有決策共用一次搜尋，stake 時開始新的一手
+  std::unique_ptr<mcts::MCTS> _session;
+  std::vector<Poker> _sessionCards;
+
+  mcts::Config _searchConfig();
+
+  mcts::SearchLimits _limits;
+
+  std::ostream* _statsLog;
+  SearchStats _lastStats;
+
+  mcts::MCTS& _search(const DecisionContext& context);
+
+  void _recordStats(const mcts::MCTS& search);
+
+  // 先查快取，沒有命中才搜尋
+  mcts::ActionTable _evaluate(const DecisionContext& context);
 };
 
 #endif
\ No newline at end of file
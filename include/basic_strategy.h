@@ -0,0 +1,35 @@
+#ifndef BASIC_STRATEGY_H
+#define BASIC_STRATEGY_H
+#include "hand_state.h"
+
+// DefaultOperation 和 MCTS 的模擬策略共用的要牌規則。
+// dealerPoint 為莊家明牌的牌值 1-10 (A 為 1)
+constexpr bool basicStrategyHit(const HandState& hand, int dealerPoint) {
+  int playerValue = hand.total();
+
+  // 檢查是否有A (軟牌)
+  bool hasSoftHand = hand.softAces > 0;
+
+  // 莊家明牌為2-6時莊家容易爆牌
+  bool dealerWeak = dealerPoint >= 2 && dealerPoint <= 6;
+
+  // 基本策略
+  if (playerValue < 12) {
+    // 點數太小，要牌
+    return true;
+  } else if (playerValue == 12) {
+    // 點數12時，當莊家牌面為2-6時不要牌，其他情況要牌
+    return !dealerWeak;
+  } else if (playerValue >= 13 && playerValue <= 16) {
+    // 點數13-16時，當莊家牌面為2-6時不要牌，其他情況要牌
+    return !dealerWeak;
+  } else if (hasSoftHand && playerValue <= 17) {
+    // 軟牌且點數小於17時要牌
+    return true;
+  }
+
+  // 點數17或以上時不要牌
+  return false;
+}
+
+#endif
@@ -0,0 +1,17 @@
+#ifndef CARD_ART_H
+#define CARD_ART_H
+#include <string>
+#include <vector>
+
+#include "poker.h"
+
+// 所有牌面圖案共用的一份表(flyweight)，第一次使用時才建立，只給輸出用
+namespace card_art {
+
+const std::vector<std::string>& front(Suit suit, int rank);
+
+const std::vector<std::string>& back();
+
+}  // namespace card_art
+
+#endif
@@ -0,0 +1,35 @@
+#ifndef CARD_SPAN_H
+#define CARD_SPAN_H
+#include <cstddef>
+#include <vector>
+
+#include "poker.h"
+
+// 不擁有資料的唯讀牌組 (C++17 還沒有 std::span)。
+// 只存指標和長度，傳值就好，指向的牌在使用期間不能被改動。
+class CardSpan {
+ public:
+  CardSpan() : _data(nullptr), _size(0) {}
+  CardSpan(const Poker* data, std::size_t size) : _data(data), _size(size) {}
+  CardSpan(const std::vector<Poker>& pokers)
+      : _data(pokers.data()), _size(pokers.size()) {}
+
+  const Poker* begin() const { return _data; }
+  const Poker* end() const { return _data + _size; }
+  std::size_t size() const { return _size; }
+  bool empty() const { return _size == 0; }
+
+  const Poker& operator[](std::size_t index) const { return _data[index]; }
+  const Poker& front() const { return _data[0]; }
+  const Poker& back() const { return _data[_size - 1]; }
+
+  std::vector<Poker> toVector() const {
+    return std::vector<Poker>(begin(), end());
+  }
+
+ private:
+  const Poker* _data;
+  std::size_t _size;
+};
+
+#endif
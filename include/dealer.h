@@ -5,13 +5,16 @@
 
 #include "player.h"
 #include "poker.h"
+#include "rng.h"
 
 class Dealer {
  public:
-  static void shuffle(std::vector<Poker>&);
-  static void deal(std::vector<Player>&, std::vector<Poker>&);
-  static void deal(Player&, std::vector<Poker>&, bool);
+  static void shuffle(std::vector<Poker>&, Xoshiro256&);
+  // 從牌堆隨機抽一張(部分 Fisher-Yates)，抽幾張就只換幾次，不用先洗整副牌
+  static Poker draw(std::vector<Poker>&, Xoshiro256&);
+  static void deal(std::vector<Player>&, std::vector<Poker>&, Xoshiro256&);
+  static void deal(Player&, std::vector<Poker>&, bool, Xoshiro256&);
   static void reduceCard(std::vector<Player>&);
 };
 
-#endif
\ No newline at end of file
+#endif
@@ -0,0 +1,65 @@
+#ifndef DEALER_ODDS_H
+#define DEALER_ODDS_H
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+
+#include "hand_state.h"
+#include "shoe.h"
+
+// 莊家停牌時的最終結果
+enum DealerResult {
+  DEALER_17,
+  DEALER_18,
+  DEALER_19,
+  DEALER_20,
+  DEALER_21,
+  DEALER_BUST,
+  DEALER_BLACKJACK,
+  DEALER_RESULTS,
+};
+
+using DealerDistribution = std::array<double, DEALER_RESULTS>;
+
+// 精確計算 H17 規則下莊家最終點數的機率分佈。
+// 莊家明牌確定，底牌和之後抽的牌都從 shoe 裡不放回地抽出。
+// 結果依(明牌, 牌靴組成)快取，超過上限時整個清空。
+class DealerOdds {
+ public:
+  explicit DealerOdds(std::size_t maxEntries = 1 << 14);
+
+  // upcard 為明牌牌值 1-10，shoe 為莊家還沒拿到的牌(包含底牌)
+  const DealerDistribution& distribution(int upcard, const Shoe& shoe);
+
+  std::size_t size() const { return _cache.size(); }
+  void clear() { _cache.clear(); }
+
+  // 每個執行緒各自一份，平行的模擬不需要上鎖
+  static DealerOdds& threadLocal();
+
+ private:
+  struct Key {
+    int upcard;
+    Shoe shoe;
+    bool operator==(const Key& key) const {
+      return upcard == key.upcard && shoe == key.shoe;
+    }
+  };
+  struct KeyHash {
+    std::size_t operator()(const Key& key) const {
+      return key.shoe.hash() * 31 + key.upcard;
+    }
+  };
+
+  // 抽到的牌只跟組合有關、跟順序無關，所以用抽出的各點數張數當 key 記憶
+  DealerDistribution _solve(const HandState& hand, Shoe& shoe,
+                            std::uint64_t drawn,
+                            std::unordered_map<std::uint64_t,
+                                               DealerDistribution>& memo);
+
+  std::size_t _maxEntries;
+  std::unordered_map<Key, DealerDistribution, KeyHash> _cache;
+};
+
+#endif
@@ -0,0 +1,108 @@
+#ifndef DECISION_CACHE_H
+#define DECISION_CACHE_H
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+
+#include "hand_state.h"
+#include "mcts.h"
+#include "shoe.h"
+
+struct DecisionCacheConfig {
+  // 最多存幾個狀態，平均分到每個分片，除不盡的部分不用；至少為 1
+  std::size_t capacity = 1 << 16;
+  // 牌靴每種牌值的張數除以這個數字後才當 key，越大越容易命中但越不精確；
+  // 1 表示牌靴組成要完全一樣
+  int shoeBucket = 4;
+  // 分片數，每個分片各自一把鎖；超過 capacity 時減到 capacity
+  int shards = 16;
+};
+
+// 快取 MCTS 根節點的動作統計。同樣的(手牌組成, 莊家明牌, 有沒有買保險,
+// 大致的牌靴組成)在不同局、不同座位會一直重複出現，命中時不用再搜尋。
+// 分片各自上鎖，多個 AIOperation 可以同時使用；每個分片滿了之後淘汰
+// 最久沒用到的狀態。
+class DecisionCache {
+ public:
+  struct Key {
+    // 手牌狀態、明牌和保險壓在一起
+    std::uint64_t state;
+    std::array<std::uint16_t, Shoe::POINTS> shoe;
+    std::uint64_t hash;
+
+    bool operator==(const Key& key) const {
+      return state == key.state && shoe == key.shoe;
+    }
+  };
+
+  struct Stats {
+    std::uint64_t hits = 0;
+    std::uint64_t misses = 0;
+    std::uint64_t insertions = 0;
+    std::uint64_t evictions = 0;
+
+    double hitRate() const {
+      std::uint64_t lookups = hits + misses;
+      return lookups == 0 ? 0 : static_cast<double>(hits) / lookups;
+    }
+  };
+
+  explicit DecisionCache(
+      const DecisionCacheConfig& config = DecisionCacheConfig());
+
+  DecisionCache(const DecisionCache&) = delete;
+  DecisionCache& operator=(const DecisionCache&) = delete;
+
+  // upcard 為莊家明牌牌值 1-10，unseen 為玩家看不到的牌
+  Key keyOf(const HandState& hand, int upcard, bool insured,
+            const Shoe& unseen) const;
+
+  // 命中時把統計值寫進 table 並回傳 true
+  bool find(const Key& key, mcts::ActionTable& table);
+
+  void insert(const Key& key, const mcts::ActionTable& table);
+
+  Stats stats() const;
+  std::size_t size() const;
+  void clear();
+
+  const DecisionCacheConfig& config() const { return _config; }
+
+  // 整個程式共用的快取，第一次使用時建立
+  static DecisionCache& shared();
+
+ private:
+  struct KeyHash {
+    std::size_t operator()(const Key& key) const { return key.hash; }
+  };
+
+  struct Entry {
+    Key key;
+    mcts::ActionTable table;
+  };
+
+  // 最近用到的放在 lru 最前面，index 指向 lru 裡的位置
+  struct alignas(64) Shard {
+    std::mutex mutex;
+    std::list<Entry> lru;
+    std::unordered_map<Key, std::list<Entry>::iterator, KeyHash> index;
+  };
+
+  Shard& _shardOf(const Key& key) const;
+
+  DecisionCacheConfig _config;
+  std::size_t _shardCapacity;
+  std::unique_ptr<Shard[]> _shards;
+
+  std::atomic<std::uint64_t> _hits;
+  std::atomic<std::uint64_t> _misses;
+  std::atomic<std::uint64_t> _insertions;
+  std::atomic<std::uint64_t> _evictions;
+};
+
+#endif
@@ -0,0 +1,29 @@
+#ifndef DECISION_CONTEXT_H
+#define DECISION_CONTEXT_H
+#include <cstdint>
+
+#include "card_span.h"
+#include "shoe.h"
+#include "table_context.h"
+
+// 一次決策看得到的所有資訊。全部是指向 Game 狀態的唯讀 view，
+// 只在這次呼叫期間有效，需要保留的話要自己複製。
+struct DecisionContext {
+  // 玩家自己的牌
+  CardSpan hand;
+  // 莊家翻開的牌，下注時還沒發牌所以是空的
+  CardSpan dealerVisible;
+  // 玩家看不到的牌(牌堆加上莊家的底牌)的組成
+  const Shoe& unseen;
+  int money;
+  const TableContext& table;
+};
+
+// 拿到前兩張牌後的選擇
+enum class OpeningDecision : std::uint8_t {
+  NOTHING,
+  DOUBLE,
+  SURRENDER,
+};
+
+#endif
@@ -0,0 +1,18 @@
+#ifndef EXACT_OPERATION_H
+#define EXACT_OPERATION_H
+#include "exact_solver.h"
+#include "operation.h"
+
+// 用 ExactSolver 算出每個動作的精確期望值，選期望值最高的動作
+class ExactOperation : public Operation {
+ public:
+  OpeningDecision doubleOrSurrender(const DecisionContext&) override;
+  bool hit(const DecisionContext&) override;
+  bool insurance(const DecisionContext&) override;
+  int stake(const DecisionContext&) override;
+
+ private:
+  ExactSolver _solver;
+};
+
+#endif
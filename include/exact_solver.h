@@ -0,0 +1,72 @@
+#ifndef EXACT_SOLVER_H
+#define EXACT_SOLVER_H
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+
+#include "dealer_odds.h"
+#include "hand_state.h"
+#include "shoe.h"
+
+// 每個動作的期望值，以一倍賭注為單位
+struct ActionValues {
+  double stand;
+  double hit;
+  double doubleDown;
+  double surrender;
+  // 保險是額外的賭注，這裡只算保險本身的期望值
+  double insurance;
+};
+
+// 依目前的手牌、莊家明牌和剩下的牌靴組成，用記憶化遞迴算出每個動作的精確期望值。
+// 賠率和 Game::_settle 一致：五張牌查理和 6-7-8 順子賠 2 倍，黑傑克賠 1.5 倍，
+// 莊家依 H17 規則抽牌。
+class ExactSolver {
+ public:
+  explicit ExactSolver(std::size_t maxEntries = 1 << 16);
+
+  // shoe 為玩家看不到的牌(包含莊家底牌)
+  ActionValues evaluate(const HandState& hand, int upcard, const Shoe& shoe);
+
+  double stand(const HandState& hand, int upcard, const Shoe& shoe);
+  // 要一張牌之後照最佳策略繼續玩的期望值
+  double hit(const HandState& hand, int upcard, const Shoe& shoe);
+  double doubleDown(const HandState& hand, int upcard, const Shoe& shoe);
+  double insurance(int upcard, const Shoe& shoe) const;
+
+  std::size_t size() const { return _cache.size(); }
+  void clear() { _cache.clear(); }
+
+ private:
+  struct Key {
+    HandState hand;
+    int upcard;
+    Shoe shoe;
+    bool operator==(const Key& key) const {
+      return hand.hardTotal == key.hand.hardTotal &&
+             hand.softAces == key.hand.softAces &&
+             hand.cardCount == key.hand.cardCount &&
+             hand.flags == key.hand.flags && upcard == key.upcard &&
+             shoe == key.shoe;
+    }
+  };
+  struct KeyHash {
+    std::size_t operator()(const Key& key) const {
+      std::uint64_t h = key.shoe.hash();
+      h = h * 31 + key.hand.hardTotal;
+      h = h * 31 + key.hand.softAces;
+      h = h * 31 + key.hand.cardCount;
+      h = h * 31 + key.hand.flags;
+      return h * 31 + key.upcard;
+    }
+  };
+
+  // 拿到這手牌之後(還可以繼續要牌)的最佳期望值
+  double _best(const HandState& hand, int upcard, const Shoe& shoe);
+
+  std::size_t _maxEntries;
+  DealerOdds _dealerOdds;
+  std::unordered_map<Key, double, KeyHash> _cache;
+};
+
+#endif
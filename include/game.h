@@ -1,32 +1,73 @@
 #ifndef GAME_H
 #define GAME_H
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <string>
 #include <vector>
 
 #include "ai_operation.h"
 #include "dealer.h"
+#include "decision_context.h"
 #include "default_operation.h"
 #include "manual_operation.h"
 #include "operation.h"
 #include "player.h"
 #include "poker.h"
+#include "renderer.h"
+#include "rng.h"
+#include "shoe.h"
+#include "simulation_result.h"
+#include "strategy_table.h"
+#include "table_context.h"
+#include "thread_pool.h"
+
+// 建立一張牌桌需要的設定
+struct GameConfig {
+  int decks = 4;
+  int leastBet = 1000;
+  // 玩家人數(2-4)，0 表示開始時詢問
+  int seats = 0;
+  // 要玩幾局，0 表示開始時詢問
+  int rounds = 0;
+  // 牌堆的亂數種子
+  std::uint64_t seed = Xoshiro256::randomSeed();
+  // 有真人玩家時，AI 每次決策最多想多久
+  std::chrono::milliseconds aiTimeLimit{50};
+  // 離線產生的策略表(generate_strategy_table 的輸出)。不是空的時 AI 座位
+  // 改用 TableOperation 查表，不做搜尋；表的副數必須跟 decks 一樣
+  std::string strategyTable;
+};
 
+// 一張牌桌。每個 Game 只用自己的玩家、牌堆和亂數，同一個程式裡可以同時開很多張
 class Game {
  private:
-  // singleton
-  Game();
-  static Game *_instance;
+  GameConfig _config;
+  TableContext _table;
+  Renderer *_renderer;
 
   bool _isRunning;
 
   int _rounds;
   int _currentRound;
   int _playerCount;
-  int _leastBet;
   std::vector<Player> _players;
   std::vector<Player> _leaderboard;
   Player *_banker;
 
   std::vector<Poker> _cardPool;
+  // 玩家看不到的牌(牌堆加上莊家的底牌)，發牌、翻牌時跟著更新
+  Shoe _unseen;
+
+  Xoshiro256 _rng;
+
+  // config.strategyTable 映射出來的表，沒有設定時是 nullptr
+  std::shared_ptr<const StrategyTable> _strategyTable;
+
+  // 依 config 開啟策略表，沒有設定時回傳 nullptr
+  static std::shared_ptr<const StrategyTable> _openStrategyTable(
+      const GameConfig &config);
 
   void _inputPlayerCount();
   void _inputRoundCount();
@@ -36,10 +77,16 @@ class Game {
   void _updateLeaderboard();
   void _printLeaderboard();
   void _printFinalLeaderboard();
-  void _printAction(std::string, bool);
+  void _printAction(PlayerAction, bool, int amount = 0);
 
   void _initCardPool();
 
+  // 每人發兩張牌並蓋住莊家的第二張
+  void _dealOpeningCards();
+
+  // 開牌後玩家做決策時看到的資訊
+  DecisionContext _contextFor(Player &) const;
+
   void _decideTheBanker();
 
   void _showAllCard();
@@ -57,12 +104,28 @@ class Game {
   void _settle();
 
   void _kickOut();
-  bool _isSoft17(std::vector<Poker> &cards);
 
- public:
-  static Game &getInstance();
+  // 用目前的玩家連續玩 games 局測試局，每玩完一局 progress 加一
+  SimulationResult _playTestGames(int games, std::atomic<long long> &progress);
 
-  int getLeasetBet();
+ public:
+  // 所有輸出都交給 renderer，批次模擬時用 NullRenderer
+  explicit Game(const GameConfig &config = GameConfig(),
+                Renderer &renderer = TerminalRenderer::standard());
+
+  // 玩家的 _banker 指向自己的 _players，不能複製
+  Game(const Game &) = delete;
+  Game &operator=(const Game &) = delete;
+
+  // 把 totalGames 局自我對戰分成 shards 份丟給線程池，每份有自己的 Game、
+  // 牌堆和亂數串流；結果依分片順序合併，同樣的 config.seed 和 shards 結果相同
+  static SimulationResult simulate(const GameConfig &config,
+                                   long long totalGames, int shards,
+                                   ThreadPool &pool = ThreadPool::shared(),
+                                   std::atomic<long long> *progress = nullptr);
+
+  int getLeasetBet() const { return _table.leastBet; }
+  const TableContext &getTable() const { return _table; }
 
   void start(bool);
 
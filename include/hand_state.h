@@ -0,0 +1,68 @@
+#ifndef HAND_STATE_H
+#define HAND_STATE_H
+#include <array>
+#include <cstdint>
+#include <vector>
+
+#include "card_span.h"
+#include "poker.h"
+
+// 查表取得每個點數(rank 1-13)的牌值，A 先算 1 點
+constexpr std::array<std::uint8_t, 14> RANK_POINT = {0, 1, 2, 3,  4,  5,  6,
+                                                     7, 8, 9, 10, 10, 10, 10};
+
+// 一手牌的增量狀態，每加一張牌 O(1) 更新，Player、Game 和 MCTS 共用
+struct HandState {
+  static constexpr std::uint8_t SEEN_6 = 1 << 0;
+  static constexpr std::uint8_t SEEN_7 = 1 << 1;
+  static constexpr std::uint8_t SEEN_8 = 1 << 2;
+  static constexpr std::uint8_t BLACKJACK = 1 << 3;
+  static constexpr std::uint8_t FIVE_CARD_CHARLIE = 1 << 4;
+  static constexpr std::uint8_t SHUN = 1 << 5;
+
+  std::uint8_t hardTotal = 0;  // A 全部算 1 點的總和
+  std::uint8_t softAces = 0;   // 手上 A 的張數
+  std::uint8_t cardCount = 0;
+  std::uint8_t flags = 0;
+
+  // point 為牌值 1-10 (A 為 1)
+  constexpr void addPoint(int point) {
+    hardTotal += point;
+    cardCount++;
+    if (point == 1) softAces++;
+    if (point >= 6 && point <= 8) flags |= SEEN_6 << (point - 6);
+
+    flags &= ~(BLACKJACK | FIVE_CARD_CHARLIE | SHUN);
+    if (cardCount == 2 && total() == 21) flags |= BLACKJACK;
+    if (cardCount == 5 && hardTotal <= 21) flags |= FIVE_CARD_CHARLIE;
+    if (cardCount == 3 && (flags & (SEEN_6 | SEEN_7 | SEEN_8)) ==
+                              (SEEN_6 | SEEN_7 | SEEN_8))
+      flags |= SHUN;
+  }
+
+  void add(Poker poker) { addPoint(RANK_POINT[poker.getRank()]); }
+
+  // 只計算翻開的牌
+  static HandState of(CardSpan pokers) {
+    HandState hand;
+    for (auto poker : pokers) {
+      if (poker.isFaceUp()) hand.add(poker);
+    }
+    return hand;
+  }
+
+  // 有 A 且把一張 A 算 11 點不會爆牌時就是軟牌
+  constexpr bool isSoft() const { return softAces > 0 && hardTotal + 10 <= 21; }
+  constexpr int total() const { return isSoft() ? hardTotal + 10 : hardTotal; }
+  constexpr bool isBust() const { return hardTotal > 21; }
+  constexpr bool isBlackjack() const { return flags & BLACKJACK; }
+  constexpr bool isFiveCardCharlie() const { return flags & FIVE_CARD_CHARLIE; }
+  constexpr bool isShun() const { return flags & SHUN; }
+
+  // 莊家 H17 規則：小於17點或軟17都要繼續抽牌
+  constexpr bool dealerShouldHit() const {
+    return total() < 17 || (total() == 17 && isSoft());
+  }
+};
+
+#endif
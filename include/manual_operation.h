@@ -4,13 +4,10 @@
 
 class ManualOperation : public Operation {
  public:
-  std::map<std::string, bool> doubleOrSurrender(std::vector<Poker>,
-                                                std::vector<Poker>,
-                                                std::vector<Poker>) override;
-  bool hit(std::vector<Poker>, std::vector<Poker>, std::vector<Poker>) override;
-  bool insurance(std::vector<Poker>, std::vector<Poker>,
-                 std::vector<Poker>) override;
-  int stake(int, std::vector<Poker>, std::vector<Poker>) override;
+  OpeningDecision doubleOrSurrender(const DecisionContext&) override;
+  bool hit(const DecisionContext&) override;
+  bool insurance(const DecisionContext&) override;
+  int stake(const DecisionContext&) override;
 };
 
 #endif
\ No newline at end of file
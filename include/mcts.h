@@ -3,14 +3,27 @@
 #include <algorithm>
 #include <array>
 #include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <initializer_list>
+#include <limits>
 #include <memory>
+#include <mutex>
 #include <random>
 #include <thread>
 
+#include "card_span.h"
+#include "hand_state.h"
 #include "poker.h"
+#include "rng.h"
+#include "rollout_policy.h"
+#include "search_stats.h"
+#include "shoe.h"
 #include "thread_pool.h"
 
 #define MAX_CHILDREN 5
+// 機會節點依抽到的牌值(A、2-9、10點牌)分出的子節點數
+#define MAX_OUTCOMES 10
 
 const double SPECIAL_WIN_VALUE = 62.5 / 75;
 const double NORMAL_WIN_VALUE = 50.0 / 75;
@@ -24,7 +37,7 @@ const double INSURANCE_FAIL_VALUE = 12.5 / 75;
 
 namespace mcts {
 
-enum Action {
+enum Action : std::uint8_t {
   HIT,
   STAND,
   DOUBLE,
@@ -32,52 +45,295 @@ enum Action {
   INSURANCE,
 };
 
+// 平行搜尋的方式
+enum class ParallelMode : std::uint8_t {
+  // 一條執行緒跑搜尋，每個葉節點的模擬分給執行緒池
+  LEAF,
+  // 多條執行緒共用同一棵樹，各自跑完整的選擇、展開、模擬、回傳
+  TREE,
+  // 每條執行緒各自建一棵樹，最後合併根節點的統計值
+  ROOT,
+};
+
+// 搜尋參數
+struct Config {
+  // 每個葉節點模擬的次數。基本策略模擬的誤差主要來自策略本身，
+  // 超過幾百次之後再加也不會更準
+  int playoutsPerLeaf = 200;
+
+  // 用 DealerOdds 算出莊家的精確結果分佈，取代逐張抽牌模擬莊家
+  bool exactDealer = true;
+
+  // 逐張抽牌模擬莊家時，底牌依牌靴組成分層：每種牌值分到的模擬次數跟
+  // 抽到的機率成比例，結果再依機率加權，底牌本身不會帶來抽樣誤差
+  bool stratifiedHoleCard = true;
+
+  // 模擬兩兩配成一對，第二次的每張牌用第一次同一張牌的 1 - u 抽，
+  // 一次抽到小牌另一次就抽到大牌，兩次的結果互相抵消一部分誤差
+  bool antitheticDraws = false;
+
+  // 亂數主種子，每個模擬任務的串流都由它推出。同一個種子只有在
+  // threads == 1 或 parallel 不是 TREE 時才保證搜出一樣的樹：
+  // 樹平行搜尋時各執行緒的選擇順序會互相影響
+  std::uint64_t seed = Xoshiro256::randomSeed();
+
+  ParallelMode parallel = ParallelMode::TREE;
+
+  // 搜尋用的執行緒數量，0 表示跟執行緒池一樣
+  int threads = 0;
+
+  // 搜尋任務送去的執行緒池，nullptr 表示用 ThreadPool::shared()
+  ThreadPool* pool = nullptr;
+
+  // 葉節點之後玩家怎麼繼續玩，nullptr 表示用 BasicStrategyPolicy::shared()
+  const RolloutPolicy* rollout = nullptr;
+};
+
+// 節點在 arena 裡的索引
+using NodeId = std::uint32_t;
+const NodeId NO_NODE = std::numeric_limits<NodeId>::max();
+
+// 節點只記錄動作和統計值，手牌和牌靴由根節點的狀態沿著路徑推出來。
+// 要牌的子節點是機會節點，底下每種抽到的牌值各一個決策節點，
+// 同一種牌之後的統計值共用，實際拿到牌時整棵子樹可以直接沿用。
+// 統計值是 atomic，樹平行搜尋時多條執行緒可以同時更新。
 class Node {
  public:
-  std::shared_ptr<Node> parent;
+  static constexpr std::uint8_t UNEXPANDED = 0;
+  static constexpr std::uint8_t EXPANDING = 1;
+  static constexpr std::uint8_t EXPANDED = 2;
 
-  std::array<std::shared_ptr<Node>, MAX_CHILDREN> children;
+  Node();
+  // 只在單執行緒時複製(arena 擴充或建立子樹)
+  Node(const Node& node);
+  Node& operator=(const Node& node);
 
-  double value;
+  NodeId parent;
+
+  // 只有 expandState 為 EXPANDED 之後才能讀。
+  // 決策節點用動作當索引，機會節點用抽到的牌值 - 1 當索引
+  std::array<NodeId, MAX_OUTCOMES> children;
+
+  std::atomic<float> value;
+
+  // 每次葉節點原始模擬結果的平方和，提早停止時用來估計變異數。
+  // 機會節點往上傳的是加權平均，但這裡一律記原始結果，變異數才不會被低估
+  std::atomic<float> squares;
+
+  std::atomic<std::uint32_t> visits;
 
-  int visits;
+  // 正在經過這個節點但還沒回傳結果的執行緒數，選擇時當成輸掉的訪問，
+  // 讓其他執行緒先去走別的分支
+  std::atomic<std::uint32_t> virtualLoss;
 
-  int drawCount;
+  // 同一個節點只讓一條執行緒展開
+  std::atomic<std::uint8_t> expandState;
 
-  std::vector<Poker> pokers;
-  std::vector<Poker> cardPool;
+  // 從根節點到這個節點(含)玩家要了幾張牌
+  std::uint8_t drawCount;
+
+  // 要了牌但還沒看到是哪張，子節點依牌值分開
+  bool chance;
+
+  // 機會節點底下的子節點抽到的牌值 1-10，其他節點是 0
+  std::uint8_t point;
+
+  // 這條路徑上有沒有買保險
+  bool insured;
 
   Action action;
 
-  double getUCBValue() const;
+  // result 算進平均價值，sample 是這次葉節點的原始結果，算進平方和
+  void addResult(double result, double sample);
+
+  // 機會節點用：多算一次訪問，平均價值直接換成 mean
+  void setMean(double mean, double sample);
+
+  double getUCBValue(std::uint32_t parentVisits) const;
+};
+
+// 根節點每個動作的統計
+struct ActionStats {
+  bool available;
+  std::uint32_t visits;
+  // 平均價值
+  double value;
+};
+
+using ActionTable = std::array<ActionStats, MAX_CHILDREN>;
+
+// 在 table 允許的動作中選訪問次數最多的，都沒有時回傳 STAND
+Action bestAction(const ActionTable& table,
+                  std::initializer_list<Action> allowed);
+
+// 搜尋的停止條件，哪一個先到就停在那裡。全部不設定時跑建構時給的次數
+struct SearchLimits {
+  // 迭代次數，小於 0 表示不限制
+  int iterations = -1;
+  // 模擬次數，0 表示不限制
+  std::uint64_t playouts = 0;
+  // 這次搜尋新建的節點數，0 表示不限制
+  std::uint64_t nodes = 0;
+  // 搜尋時間，0 表示不限制；會多花最多一次迭代的時間
+  std::chrono::nanoseconds timeLimit{0};
+  // 大於 0 時，根節點最好的動作跟其他動作的信賴區間在這個信心水準下
+  // 分開就提早停，例如 0.95；0 表示不提早停
+  double confidence = 0;
+
+  bool unlimited() const {
+    return iterations < 0 && playouts == 0 && nodes == 0 &&
+           timeLimit.count() <= 0;
+  }
+};
+
+// 搜尋停下來時的結果
+struct SearchResult {
+  // 根節點所有動作中訪問次數最多的
+  Action best;
+  ActionTable actions;
+  SearchStats stats;
 };
 
 class MCTS {
  public:
   MCTS(int simualtions, std::vector<Poker> pokers,
-       std::vector<Poker> knownCardPool, std::vector<Poker> dealerVisibleCards);
+       std::vector<Poker> knownCardPool, std::vector<Poker> dealerVisibleCards,
+       Config config = Config());
+
+  // 直接用手牌狀態和看不到的牌的組成建立，不需要整副牌的 vector
+  MCTS(int simualtions, const HandState& hand, const Shoe& unseen,
+       CardSpan dealerVisibleCards, Config config = Config());
+
+  // 模擬 node 的結果平均值，不會動到樹
+  double playout(NodeId node);
 
-  std::shared_ptr<Node> selection(std::shared_ptr<Node> root);
+  const Node& run();
 
-  void expansion(std::shared_ptr<Node> node);
+  // 從目前的根節點再多跑 iterations 次，已有的統計值會保留
+  const Node& run(int iterations);
 
-  double playout(std::shared_ptr<Node> node);
+  // 隨時可停的搜尋：從目前的根節點繼續搜，直到 limits 其中一個條件達到
+  SearchResult search(const SearchLimits& limits);
 
-  std::shared_ptr<Node> run();
+  ActionTable actionTable() const;
 
-  void backpropagation(std::shared_ptr<Node> node, double result);
+  // 在允許的動作中選訪問次數最多的
+  Action bestAction(std::initializer_list<Action> allowed) const;
+
+  // 做了某個動作後，把對應的子樹升為新的根節點；要牌用 advance(Poker)
+  void advance(Action action);
+
+  // 玩家實際拿到一張牌：HIT 機會節點底下這張牌的子樹升為根節點並更新手牌
+  void advance(Poker dealt);
+
+  // 其他玩家拿牌之後用實際剩下的牌更新根節點的牌靴
+  void updateShoe(const std::vector<Poker>& knownCardPool);
+  void updateShoe(const Shoe& unseen);
+
+  const Node& node(NodeId id) const { return _nodes[id]; }
+
+  std::size_t nodeCount() const { return _nodeCount.load(); }
+
+  // 最近一次 run 的統計，run 開始時歸零
+  const SearchStats& stats() const { return _stats; }
 
   std::vector<Poker> dealerVisibleCards;
 
-  std::shared_ptr<Node> root;
+  NodeId root;
 
  private:
+  // 根平行搜尋用：複製 search 的根節點狀態建一棵獨立的單執行緒樹
+  MCTS(const MCTS& search, std::uint64_t seed);
+
+  // 下面三個階段只能在 _search 裡用：arena 要先留好空間，
+  // 根節點要先加上 virtual loss(見 _iterate)
+
+  // 從 root 往下選到葉節點，經過的節點(不含 root)都會加上 virtual loss
+  NodeId selection(NodeId root);
+
+  void expansion(NodeId node);
+
+  // 回傳結果並移除 selection 加上的 virtual loss
+  void backpropagation(NodeId node, double result);
+
+  // point 不是 0 時建立機會節點底下抽到這個牌值的子節點
+  NodeId _newNode(NodeId parent, Action action, std::uint8_t point = 0);
+
+  // 根節點的手牌和牌靴加上 node 路徑上抽到的牌
+  void _stateAt(NodeId node, HandState& hand, Shoe& shoe) const;
+
+  // 決策節點：選 UCB 最高的子節點
+  NodeId _selectAction(NodeId node) const;
+
+  // 機會節點：選實際訪問次數比依機率應得的次數少最多的牌值
+  NodeId _selectOutcome(NodeId node, const Shoe& shoe) const;
+
+  // 機會節點已訪問的子節點依抽到的機率加權的平均價值，都沒訪問過時回傳 fallback
+  double _expectedValue(NodeId node, const Shoe& shoe, double fallback) const;
+
+  // 確保 arena 還放得下 count 個節點，只能在沒有其他執行緒搜尋時呼叫
+  void _reserveNodes(std::size_t count);
+
+  bool _isLegal(NodeId node, Action action) const;
+
+  bool _isTerminal(NodeId node) const;
+
+  // 一次完整的選擇、展開、模擬、回傳；rng 為 nullptr 時模擬分給執行緒池。
+  // 各階段的時間記在 stats，只有呼叫的執行緒會寫
+  void _iterate(Xoshiro256* rng, SearchStats& stats);
+
+  // 把葉節點的模擬分給執行緒池，順便記錄等待其他線程的時間
+  double _playout(NodeId node, SearchStats& stats);
+
+  // node 在根節點下面第幾層
+  std::uint32_t _depth(NodeId node) const;
+
+  using TimePoint = std::chrono::steady_clock::time_point;
+
+  // search 的本體，deadline 已經換算成時間點
+  void _search(const SearchLimits& limits, TimePoint deadline);
+
+  // 跑最多 iterations 次，時間到就提早停；arena 要先留好空間
+  void _runBatch(int iterations, TimePoint deadline);
+
+  void _runTree(int iterations, TimePoint deadline);
+
+  // 每條執行緒各自的樹分到一份預算，自己分批搜到停止條件
+  void _runRoot(const SearchLimits& limits, TimePoint deadline);
+
+  // 根節點訪問次數最多的子節點，沒有子節點時回傳 NO_NODE
+  NodeId _bestChild() const;
+
+  // 根節點最好的子節點的信賴區間下界是否高於其他子節點的上界
+  bool _separated(double confidence) const;
+
+  // 在目前的執行緒上模擬 playoutCount 次，回傳價值總和
+  double _simulate(NodeId node, int playoutCount, Xoshiro256& rng) const;
+
+  int _threadCount() const;
+
+  ThreadPool& _pool() const;
+
+  const RolloutPolicy& _rollout() const;
+
   int _simulations;
 
-  std::unique_ptr<ThreadPool> _threadPool;
+  Config _config;
+
+  // 已經用掉的亂數串流數量
+  std::uint64_t _nextStream;
+
+  // 所有節點連續放在一起，用索引互相指向。搜尋前先把空間留好，
+  // 搜尋中只用 _nodeCount 分配位置，不會重新配置
+  std::vector<Node> _nodes;
+  std::atomic<NodeId> _nodeCount;
 
-  int _playoutTimes;
+  // 根節點的手牌和玩家看不到的牌
+  HandState _rootHand;
+  Shoe _rootShoe;
 
-  std::mt19937 _rng;
+  SearchStats _stats;
+  // 樹平行時每條執行緒搜完才合併一次
+  std::mutex _statsMutex;
 };
 }  // namespace mcts
\ No newline at end of file
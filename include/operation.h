@@ -1,20 +1,15 @@
 #ifndef OPERATION_H
 #define OPERATION_H
-#include <map>
-#include <string>
-
-#include "poker.h"
+#include "decision_context.h"
 
 class Operation {
  public:
-  virtual std::map<std::string, bool> doubleOrSurrender(std::vector<Poker>,
-                                                        std::vector<Poker>,
-                                                        std::vector<Poker>) = 0;
-  virtual bool hit(std::vector<Poker>, std::vector<Poker>,
-                   std::vector<Poker>) = 0;
-  virtual bool insurance(std::vector<Poker>, std::vector<Poker>,
-                         std::vector<Poker>) = 0;
-  virtual int stake(int, std::vector<Poker>, std::vector<Poker>) = 0;
+  virtual ~Operation() = default;
+
+  virtual OpeningDecision doubleOrSurrender(const DecisionContext&) = 0;
+  virtual bool hit(const DecisionContext&) = 0;
+  virtual bool insurance(const DecisionContext&) = 0;
+  virtual int stake(const DecisionContext&) = 0;
 };
 
-#endif
\ No newline at end of file
+#endif
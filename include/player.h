@@ -2,6 +2,7 @@
 #define PLAYER_H
 #include <vector>
 
+#include "hand_state.h"
 #include "operation.h"
 #include "poker.h"
 
@@ -44,10 +45,13 @@ class Player {
   void lossInsurance();
   void out();
   std::string getName();
+  bool isBanker();
+  bool isOut();
   void addPoker(Poker);
   void clearPoker();
   int getProfit();
   int getPoint();
+  HandState getHand();
   int getBet();
   int getTotalProfit();
   std::vector<Poker> &getPokers();
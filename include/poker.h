@@ -1,74 +1,51 @@
 #ifndef POKER_H
 #define POKER_H
+#include <cstdint>
 #include <iostream>
-#include <vector>
 #include <string>
+#include <vector>
 
 enum Suit { spade, heart, diamond, club };
 
+// 一張牌只佔 1 byte：bit 0-3 為點數(1-13)，bit 4-5 為花色，bit 6 為是否翻開。
+// 牌面圖案放在 card_art 的共用表中，只有輸出時才會用到。
 class Poker {
  public:
-  void showAttribute();
-  void setSuit(Suit suit);
-  void setNumber(std::string number);
+  static constexpr int ACE = 1;
+  static constexpr int JACK = 11;
+  static constexpr int QUEEN = 12;
+  static constexpr int KING = 13;
+
+  void showAttribute() const;
   Poker(Suit, std::string);
+  Poker(Suit, int);
   Poker();
-  Suit getSuit();
-  std::string getNumber();
-  std::vector<std::string> getPattern();
-  static void printPokers(std::vector<Poker> pokers);
+  Suit getSuit() const { return static_cast<Suit>((_bits >> 4) & 0x3); }
+  int getRank() const { return _bits & 0xF; }
+  std::string getNumber() const;
+  bool isFaceUp() const { return (_bits & FACE_UP_BIT) != 0; }
+  const std::vector<std::string>& getPattern() const;
+  static void printPokers(const std::vector<Poker>& pokers);
   static void printPokers(Poker);
-  void flipTheCard();
+  void flipTheCard() { _bits ^= FACE_UP_BIT; }
 
+  // 花色與點數相同即視為同一張牌，不管正反面
   bool operator==(const Poker& poker) const {
-    return _suit == poker._suit && _number == poker._number;
+    return (_bits & ~FACE_UP_BIT) == (poker._bits & ~FACE_UP_BIT);
   }
   bool operator!=(const Poker& poker) const { return !(*this == poker); }
 
   static int getPokerValue(Poker poker) {
-    if (poker.getNumber() == "A") return 11;
-    if (poker.getNumber() == "J" || poker.getNumber() == "Q" ||
-        poker.getNumber() == "K")
-      return 10;
-    return std::stoi(poker.getNumber());
-  }
-
-  static int getPokerValue(std::vector<Poker> pokers) {
-    int point = 0;
-    int count = 0;
-    for (auto poker : pokers) {
-      if (!poker._isFaceUp) continue;
-      if (poker.getNumber() == "A") {
-        count++;
-        continue;
-      }
-      if (poker.getNumber() == "J" || poker.getNumber() == "Q" ||
-          poker.getNumber() == "K") {
-        point += 10;
-      } else {
-        point += std::stoi(poker.getNumber());
-      }
-    }
-
-    while (count > 0) {
-      if (point + count * 11 > 21) {
-        point += 1;
-      } else {
-        point += 11;
-      }
-      count--;
-    }
-
-    return point;
+    if (poker.getRank() == ACE) return 11;
+    return poker.getRank() >= 10 ? 10 : poker.getRank();
   }
 
  private:
-  Suit _suit;
-  std::string _number;
-  bool _isFaceUp;
-  std::vector<std::string> _picture;
-  std::vector<std::string> _backPattern;
-  friend class Player;
+  static constexpr std::uint8_t FACE_UP_BIT = 0x40;
+
+  std::uint8_t _bits;
 };
 
-#endif
\ No newline at end of file
+static_assert(sizeof(Poker) == 1, "Poker must stay a 1-byte value type");
+
+#endif
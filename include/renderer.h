@@ -0,0 +1,105 @@
+#ifndef RENDERER_H
+#define RENDERER_H
+#include <vector>
+
+#include "player.h"
+#include "simulation_result.h"
+
+// 玩家在回合中做的選擇
+enum class PlayerAction {
+  STAKE,
+  DOUBLE_DOWN,
+  SURRENDER,
+  NOTHING,
+  INSURANCE,
+  NO_INSURANCE,
+  STAND,
+};
+
+// Game 的所有輸出都透過 Renderer。事件只傳原始資料，字串格式化和牌面圖案
+// 都在實作裡做，所以 NullRenderer 完全不用花時間組字串。
+class Renderer {
+ public:
+  virtual ~Renderer() = default;
+
+  // 固定的提示文字
+  virtual void message(const char *text) = 0;
+
+  virtual void roundStart(int round) = 0;
+  virtual void bankerChosen(Player &banker) = 0;
+
+  // 發完牌後顯示所有人的牌
+  virtual void table(Player &banker, std::vector<Player> &players) = 0;
+
+  // 輪到某個玩家做決定
+  virtual void turn(Player &player) = 0;
+  virtual void action(PlayerAction action, int amount = 0) = 0;
+
+  // 拿到新牌後的手牌
+  virtual void hand(Player &player, bool isBanker) = 0;
+  // 要牌之後的手牌，接在 turn 的輸出後面
+  virtual void hit(Player &player) = 0;
+  virtual void reached21(Player &player) = 0;
+  virtual void busted(Player &player, bool isBanker) = 0;
+  virtual void bankerStands(Player &banker) = 0;
+
+  // 每局結算後的結果和排行榜
+  virtual void roundResult(Player &banker, std::vector<Player> &players,
+                           std::vector<Player> &leaderboard) = 0;
+  virtual void finalLeaderboard(std::vector<Player> &leaderboard) = 0;
+  virtual void kickedOut(Player &player, bool noMoney) = 0;
+
+  // 自我對戰的進度和結果
+  virtual void progress(long long done, long long total) = 0;
+  virtual void simulationResult(const SimulationResult &result) = 0;
+};
+
+// 輸出到終端機，牌用 ASCII 圖案畫出來
+class TerminalRenderer : public Renderer {
+ public:
+  static TerminalRenderer &standard();
+
+  void message(const char *text) override;
+  void roundStart(int round) override;
+  void bankerChosen(Player &banker) override;
+  void table(Player &banker, std::vector<Player> &players) override;
+  void turn(Player &player) override;
+  void action(PlayerAction action, int amount = 0) override;
+  void hand(Player &player, bool isBanker) override;
+  void hit(Player &player) override;
+  void reached21(Player &player) override;
+  void busted(Player &player, bool isBanker) override;
+  void bankerStands(Player &banker) override;
+  void roundResult(Player &banker, std::vector<Player> &players,
+                   std::vector<Player> &leaderboard) override;
+  void finalLeaderboard(std::vector<Player> &leaderboard) override;
+  void kickedOut(Player &player, bool noMoney) override;
+  void progress(long long done, long long total) override;
+  void simulationResult(const SimulationResult &result) override;
+};
+
+// 什麼都不輸出，批次模擬用
+class NullRenderer : public Renderer {
+ public:
+  static NullRenderer &instance();
+
+  void message(const char *) override {}
+  void roundStart(int) override {}
+  void bankerChosen(Player &) override {}
+  void table(Player &, std::vector<Player> &) override {}
+  void turn(Player &) override {}
+  void action(PlayerAction, int) override {}
+  void hand(Player &, bool) override {}
+  void hit(Player &) override {}
+  void reached21(Player &) override {}
+  void busted(Player &, bool) override {}
+  void bankerStands(Player &) override {}
+  void roundResult(Player &, std::vector<Player> &,
+                   std::vector<Player> &) override {}
+  void finalLeaderboard(std::vector<Player> &) override {}
+  void kickedOut(Player &, bool) override {}
+  void progress(long long, long long) override {}
+  void simulationResult(const SimulationResult &) override {}
+};
+
+#endif
@@ -0,0 +1,60 @@
+#ifndef ROLLOUT_POLICY_H
+#define ROLLOUT_POLICY_H
+#include "hand_state.h"
+#include "rng.h"
+
+namespace mcts {
+
+// 模擬走到葉節點之後，玩家還可以行動時用來決定要不要繼續要牌。
+// 同一個策略會被多條執行緒同時使用，實作不能有可變的狀態。
+class RolloutPolicy {
+ public:
+  virtual ~RolloutPolicy() = default;
+
+  // hand 為目前的手牌，dealerPoint 為莊家明牌的牌值 1-10 (A 為 1)，
+  // hits 為這次模擬裡策略已經要了幾張牌
+  virtual bool hit(const HandState& hand, int dealerPoint, int hits,
+                   Xoshiro256& rng) const = 0;
+};
+
+// 不管點數，固定再要 count 張牌；0 表示葉節點直接停牌
+class FixedCountPolicy : public RolloutPolicy {
+ public:
+  explicit FixedCountPolicy(int count = 0) : _count(count) {}
+
+  bool hit(const HandState& hand, int dealerPoint, int hits,
+           Xoshiro256& rng) const override;
+
+ private:
+  int _count;
+};
+
+// 點數小於 21 時以 hitProbability 的機率要牌
+class RandomPolicy : public RolloutPolicy {
+ public:
+  explicit RandomPolicy(double hitProbability = 0.5)
+      : _hitProbability(hitProbability) {}
+
+  bool hit(const HandState& hand, int dealerPoint, int hits,
+           Xoshiro256& rng) const override;
+
+ private:
+  double _hitProbability;
+};
+
+// 跟 DefaultOperation 一樣的基本策略，Config 沒有指定時的預設值
+class BasicStrategyPolicy : public RolloutPolicy {
+ public:
+  bool hit(const HandState& hand, int dealerPoint, int hits,
+           Xoshiro256& rng) const override;
+
+  // 整個程式共用一個，策略本身沒有狀態
+  static const BasicStrategyPolicy& shared() {
+    static const BasicStrategyPolicy policy;
+    return policy;
+  }
+};
+
+}  // namespace mcts
+
+#endif
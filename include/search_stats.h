@@ -0,0 +1,58 @@
+#ifndef SEARCH_STATS_H
+#define SEARCH_STATS_H
+#include <algorithm>
+#include <cstdint>
+#include <string>
+
+// 搜尋為什麼停下來
+enum class StopReason : std::uint8_t {
+  ITERATIONS,
+  PLAYOUTS,
+  NODES,
+  TIME,
+  // 最好的動作跟其他動作的信賴區間已經分開
+  CONFIDENCE,
+  // 只有節點或模擬預算，但樹已經收斂，再搜也用不到預算
+  CONVERGED,
+};
+
+const char *stopReasonName(StopReason reason);
+
+// 一次 MCTS::run 的統計。各階段的時間是所有搜尋執行緒加總的時間，
+// 單位都是奈秒；wallNs 才是實際經過的時間。
+struct SearchStats {
+  std::uint64_t iterations = 0;
+  std::uint64_t nodesAllocated = 0;
+  // 從根節點往下選到最深的葉節點的深度
+  std::uint32_t maxDepth = 0;
+  std::uint64_t playouts = 0;
+
+  std::uint64_t selectionNs = 0;
+  std::uint64_t expansionNs = 0;
+  std::uint64_t playoutNs = 0;
+  std::uint64_t backpropagationNs = 0;
+  // 葉平行時，發出模擬任務的執行緒等其他線程算完的時間
+  std::uint64_t playoutWaitNs = 0;
+
+  std::uint64_t wallNs = 0;
+
+  StopReason stopReason = StopReason::ITERATIONS;
+
+  // 合併其他執行緒或其他樹的統計，wallNs 和 stopReason 不變
+  void merge(const SearchStats &stats) {
+    iterations += stats.iterations;
+    nodesAllocated += stats.nodesAllocated;
+    maxDepth = std::max(maxDepth, stats.maxDepth);
+    playouts += stats.playouts;
+    selectionNs += stats.selectionNs;
+    expansionNs += stats.expansionNs;
+    playoutNs += stats.playoutNs;
+    backpropagationNs += stats.backpropagationNs;
+    playoutWaitNs += stats.playoutWaitNs;
+  }
+
+  // 一行 JSON 物件，沒有結尾換行
+  std::string toJson() const;
+};
+
+#endif
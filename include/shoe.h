@@ -0,0 +1,79 @@
+#ifndef SHOE_H
+#define SHOE_H
+#include <array>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+#include "card_span.h"
+#include "hand_state.h"
+#include "poker.h"
+
+// 牌靴只記錄每種牌值(A、2-9、10點牌)剩下幾張，勝負只跟這個有關。
+// 抽牌時依剩餘張數加權，抽出的牌不放回。
+class Shoe {
+ public:
+  static constexpr int POINTS = 10;
+
+  Shoe() : _counts{}, _size(0) {}
+
+  static Shoe of(CardSpan pokers) {
+    Shoe shoe;
+    for (auto poker : pokers) shoe.add(poker);
+    return shoe;
+  }
+
+  // point 為牌值 1-10 (A 為 1)
+  int count(int point) const { return _counts[point - 1]; }
+  int size() const { return _size; }
+  bool empty() const { return _size == 0; }
+
+  void add(int point, int amount = 1) {
+    _counts[point - 1] += amount;
+    _size += amount;
+  }
+  void add(Poker poker) { add(RANK_POINT[poker.getRank()]); }
+
+  void remove(int point) {
+    _counts[point - 1]--;
+    _size--;
+  }
+  void remove(Poker poker) { remove(RANK_POINT[poker.getRank()]); }
+
+  // 依剩餘張數加權抽一張牌並從牌靴移除，回傳牌值；牌靴必須不是空的
+  template <class Rng>
+  int draw(Rng& rng) {
+    return drawAt(std::uniform_int_distribution<int>(0, _size - 1)(rng));
+  }
+
+  // 牌依牌值由小到大排好時，抽出第 target 張(0 到 size() - 1)並回傳牌值，
+  // 給需要自己控制亂數的抽樣方法用
+  int drawAt(int target) {
+    int point = 1;
+    while (target >= _counts[point - 1]) {
+      target -= _counts[point - 1];
+      point++;
+    }
+    remove(point);
+    return point;
+  }
+
+  // 依組成計算的雜湊值，給快取當 key 用
+  std::uint64_t hash() const {
+    std::uint64_t h = 0xCBF29CE484222325ULL;
+    for (auto count : _counts) {
+      h ^= count;
+      h *= 0x100000001B3ULL;
+    }
+    return h;
+  }
+
+  bool operator==(const Shoe& shoe) const { return _counts == shoe._counts; }
+  bool operator!=(const Shoe& shoe) const { return !(*this == shoe); }
+
+ private:
+  std::array<std::uint16_t, POINTS> _counts;
+  std::uint16_t _size;
+};
+
+#endif
@@ -0,0 +1,32 @@
+#ifndef SIMULATION_RESULT_H
+#define SIMULATION_RESULT_H
+
+// 自我對戰的統計結果，AI 的每一局收益跟 Default2 比較
+struct SimulationResult {
+  long long games = 0;
+  long long wins = 0;
+  long long losses = 0;
+  long long draws = 0;
+  long long profit = 0;
+  // AI 決策快取的命中/未命中次數
+  long long cacheHits = 0;
+  long long cacheMisses = 0;
+
+  void merge(const SimulationResult &result) {
+    games += result.games;
+    wins += result.wins;
+    losses += result.losses;
+    draws += result.draws;
+    profit += result.profit;
+    cacheHits += result.cacheHits;
+    cacheMisses += result.cacheMisses;
+  }
+
+  // 不計平局的勝率
+  double winRate() const {
+    long long decided = wins + losses;
+    return decided == 0 ? 0 : static_cast<double>(wins) / decided;
+  }
+};
+
+#endif
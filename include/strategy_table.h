@@ -0,0 +1,99 @@
+#ifndef STRATEGY_TABLE_H
+#define STRATEGY_TABLE_H
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "hand_state.h"
+#include "shoe.h"
+
+// 策略表檔案開頭，後面緊接著 entryCount 個 1 byte 的決策
+struct StrategyTableHeader {
+  char magic[8];
+  std::uint32_t version;
+  std::uint16_t decks;
+  // 第 0 個 count bucket 對應的 Hi-Lo 真數
+  std::int8_t minCount;
+  std::uint8_t countBuckets;
+  std::uint32_t entryCount;
+  std::uint32_t reserved;
+};
+
+static_assert(sizeof(StrategyTableHeader) == 24,
+              "StrategyTableHeader is part of the file format");
+
+// 離線算好的策略表。每個狀態(玩家點數, 軟牌, 張數, 莊家明牌, count bucket)
+// 對應 1 byte 的決策，查表 O(1)。
+// 從檔案開啟時直接 mmap 整個檔案，不需要解析也不用在啟動時計算。
+class StrategyTable {
+ public:
+  static constexpr char MAGIC[8] = {'B', 'J', 'S', 'T', 'R', 'A', 'T', 0};
+  static constexpr std::uint32_t VERSION = 1;
+
+  // 每個決策 byte 的位元
+  static constexpr std::uint8_t HIT = 1 << 0;
+  static constexpr std::uint8_t DOUBLE = 1 << 1;
+  static constexpr std::uint8_t SURRENDER = 1 << 2;
+  static constexpr std::uint8_t INSURANCE = 1 << 3;
+
+  // 點數 2-21、軟/硬、張數 2-5(5 張以上算 5)、明牌 1-10
+  static constexpr int TOTALS = 20;
+  static constexpr int CARD_COUNTS = 4;
+  static constexpr int UPCARDS = 10;
+  static constexpr std::size_t STATES_PER_BUCKET =
+      TOTALS * 2 * CARD_COUNTS * UPCARDS;
+
+  // 在記憶體裡建一張空表，給產生器填；真數 minCount 到
+  // minCount + countBuckets - 1 各一個 bucket
+  StrategyTable(int decks, int minCount, int countBuckets);
+
+  // mmap 開啟 path，格式或版本不對時丟 std::runtime_error；
+  // decks 大於 0 時，表不是用 decks 副牌產生的也丟 std::runtime_error
+  explicit StrategyTable(const std::string& path, int decks = 0);
+
+  ~StrategyTable();
+
+  StrategyTable(const StrategyTable&) = delete;
+  StrategyTable& operator=(const StrategyTable&) = delete;
+
+  const StrategyTableHeader& header() const { return *_header; }
+  std::size_t size() const { return _header->entryCount; }
+
+  // unseen 的 Hi-Lo 真數落在哪個 bucket，超出範圍的取最近的
+  int countBucketOf(const Shoe& unseen) const;
+
+  std::size_t indexOf(const HandState& hand, int upcard,
+                      int countBucket) const;
+
+  std::uint8_t lookup(const HandState& hand, int upcard,
+                      const Shoe& unseen) const {
+    return _entries[indexOf(hand, upcard, countBucketOf(unseen))];
+  }
+
+  // 只能用在記憶體裡建的表
+  void set(std::size_t index, std::uint8_t decision) {
+    _owned[sizeof(StrategyTableHeader) + index] = decision;
+  }
+
+  void save(const std::string& path) const;
+
+ private:
+  const StrategyTableHeader* _header;
+  const std::uint8_t* _entries;
+
+  // 記憶體裡建的表：header 和 entries 連在一起，跟檔案內容一樣
+  std::vector<std::uint8_t> _owned;
+
+  // mmap 開啟的表
+  void* _mapping;
+  std::size_t _mappedSize;
+#ifdef _WIN32
+  void* _file;
+  void* _mappingHandle;
+#endif
+
+  void _unmap();
+};
+
+#endif
@@ -0,0 +1,36 @@
+#ifndef STRATEGY_TABLE_GENERATOR_H
+#define STRATEGY_TABLE_GENERATOR_H
+#include <cstdint>
+#include <vector>
+
+#include "exact_solver.h"
+#include "strategy_table.h"
+#include "thread_pool.h"
+
+// 用 ExactSolver 填策略表，generate_strategy_table 和測試共用
+class StrategyTableGenerator {
+ public:
+  // 一個(點數, 軟牌, 張數)狀態的代表手牌，points 為依序拿到的牌值
+  struct Representative {
+    HandState hand;
+    std::vector<int> points;
+  };
+
+  // 每個(點數, 軟牌, 張數)找一手實際拿得到的牌當代表，先找到的優先
+  static std::vector<Representative> representativeHands();
+
+  // decks 副牌拿掉玩家的牌和莊家明牌之後，再拿掉一些低牌(真數為正)
+  // 或高牌(真數為負)，讓剩下的牌的 Hi-Lo 真數接近 trueCount
+  static Shoe shoeFor(int decks, int trueCount, const std::vector<int>& points,
+                      int upcard);
+
+  // 跟 ExactOperation 一樣選期望值最高的動作
+  static std::uint8_t decisionOf(const ActionValues& values);
+
+  // 算出 table 每個 count bucket、每張明牌的所有狀態，
+  // 不同的(真數, 明牌)分給 pool 平行計算；回傳算了幾個狀態
+  static std::size_t fill(StrategyTable& table,
+                          ThreadPool& pool = ThreadPool::shared());
+};
+
+#endif
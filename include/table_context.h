@@ -0,0 +1,10 @@
+#ifndef TABLE_CONTEXT_H
+#define TABLE_CONTEXT_H
+
+// 牌桌的固定設定，Game 下注時傳給 Operation，不用再去讀全域的 Game
+struct TableContext {
+  int leastBet;
+  int decks;
+};
+
+#endif
@@ -0,0 +1,23 @@
+#ifndef TABLE_OPERATION_H
+#define TABLE_OPERATION_H
+#include "operation.h"
+#include "strategy_table.h"
+
+// 直接查離線產生的策略表做決策，不做任何搜尋。
+// 同一張表可以給很多個座位共用，表的生命週期要比 TableOperation 長。
+class TableOperation : public Operation {
+ public:
+  explicit TableOperation(const StrategyTable& table) : _table(table) {}
+
+  OpeningDecision doubleOrSurrender(const DecisionContext&) override;
+  bool hit(const DecisionContext&) override;
+  bool insurance(const DecisionContext&) override;
+  int stake(const DecisionContext&) override;
+
+ private:
+  const StrategyTable& _table;
+
+  std::uint8_t _lookup(const DecisionContext& context) const;
+};
+
+#endif
@@ -1,76 +1,428 @@
 #pragma once
 
+#include <algorithm>
+#include <atomic>
 #include <condition_variable>
-#include <functional>
+#include <cstddef>
+#include <deque>
+#include <exception>
 #include <future>
 #include <memory>
 #include <mutex>
-#include <queue>
+#include <new>
 #include <stdexcept>
 #include <thread>
+#include <tuple>
+#include <type_traits>
+#include <utility>
 #include <vector>
 
-class ThreadPool {
+#ifdef __linux__
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+// 可以移動不能複製的函式包裝，小的 callable 直接放在物件裡面，不用另外配置記憶體
+class Task {
  public:
-  // 建立指定數量的工作線程
-  ThreadPool(size_t threads) {
-    for (size_t i = 0; i < threads; ++i) {
-      workers.emplace_back([this] {
-        while (true) {
-          std::function<void()> task;
-          {
-            std::unique_lock<std::mutex> lock(queue_mutex);
-            condition.wait(lock, [this] { return stop || !tasks.empty(); });
-
-            if (stop && tasks.empty()) return;
-
-            task = std::move(tasks.front());
-            tasks.pop();
-          }
-          task();
-        }
-      });
+  static constexpr std::size_t INLINE_SIZE = 56;
+
+  Task() = default;
+
+  template <class F, class = std::enable_if_t<
+                         !std::is_same<std::decay_t<F>, Task>::value>>
+  Task(F&& f) {
+    using Callable = std::decay_t<F>;
+    if constexpr (fitsInline<Callable>()) {
+      new (_storage) Callable(std::forward<F>(f));
+      _ops = &inlineOps<Callable>;
+    } else {
+      // 太大的 callable 才放到 heap 上
+      *reinterpret_cast<Callable**>(_storage) =
+          new Callable(std::forward<F>(f));
+      _ops = &heapOps<Callable>;
     }
   }
 
-  // 新增任務到線程池
-  template <class F, class... Args>
-  auto enqueue(F&& f, Args&&... args)
-      -> std::future<typename std::result_of<F(Args...)>::type> {
-    using return_type = typename std::result_of<F(Args...)>::type;
+  Task(Task&& task) noexcept { moveFrom(task); }
 
-    auto task = std::make_shared<std::packaged_task<return_type()>>(
-        std::bind(std::forward<F>(f), std::forward<Args>(args)...));
+  Task& operator=(Task&& task) noexcept {
+    if (this != &task) {
+      reset();
+      moveFrom(task);
+    }
+    return *this;
+  }
 
-    std::future<return_type> res = task->get_future();
-    {
-      std::unique_lock<std::mutex> lock(queue_mutex);
-      if (stop) throw std::runtime_error("enqueue on stopped ThreadPool");
+  Task(const Task&) = delete;
+  Task& operator=(const Task&) = delete;
+
+  ~Task() { reset(); }
 
-      tasks.emplace([task]() { (*task)(); });
+  void operator()() { _ops->invoke(_storage); }
+
+  explicit operator bool() const { return _ops != nullptr; }
+
+ private:
+  struct Ops {
+    void (*invoke)(void*);
+    void (*move)(void* to, void* from);
+    void (*destroy)(void*);
+  };
+
+  template <class Callable>
+  static constexpr bool fitsInline() {
+    return sizeof(Callable) <= INLINE_SIZE &&
+           alignof(Callable) <= alignof(std::max_align_t) &&
+           std::is_nothrow_move_constructible<Callable>::value;
+  }
+
+  template <class Callable>
+  static constexpr Ops inlineOps = {
+      [](void* storage) { (*static_cast<Callable*>(storage))(); },
+      [](void* to, void* from) {
+        new (to) Callable(std::move(*static_cast<Callable*>(from)));
+        static_cast<Callable*>(from)->~Callable();
+      },
+      [](void* storage) { static_cast<Callable*>(storage)->~Callable(); },
+  };
+
+  template <class Callable>
+  static constexpr Ops heapOps = {
+      [](void* storage) { (**static_cast<Callable**>(storage))(); },
+      [](void* to, void* from) {
+        *static_cast<Callable**>(to) = *static_cast<Callable**>(from);
+      },
+      [](void* storage) { delete *static_cast<Callable**>(storage); },
+  };
+
+  void moveFrom(Task& task) {
+    if (task._ops == nullptr) return;
+    task._ops->move(_storage, task._storage);
+    _ops = task._ops;
+    task._ops = nullptr;
+  }
+
+  void reset() {
+    if (_ops == nullptr) return;
+    _ops->destroy(_storage);
+    _ops = nullptr;
+  }
+
+  alignas(std::max_align_t) unsigned char _storage[INLINE_SIZE];
+  const Ops* _ops = nullptr;
+};
+
+class TaskGroup;
+
+// 工作竊取(work-stealing)線程池：每條工作線程有自己的佇列，自己從尾端拿，
+// 沒事做的線程從別人的佇列前端偷。工作線程送出的任務放進自己的佇列，
+// 不會跟其他線程搶同一把鎖。
+class ThreadPool {
+ public:
+  // 建立指定數量的工作線程，pinThreads 時每條線程綁定一個 CPU 核心
+  explicit ThreadPool(size_t threads, bool pinThreads = false)
+      : queues(new WorkQueue[threads > 0 ? threads : 1]),
+        queueCount(threads > 0 ? threads : 1) {
+    for (size_t i = 0; i < threads; ++i) {
+      workers.emplace_back([this, i] { workerLoop(i); });
+      if (pinThreads) pinToCore(workers.back(), i);
     }
-    condition.notify_one();
-    return res;
   }
 
+  ThreadPool(const ThreadPool&) = delete;
+  ThreadPool& operator=(const ThreadPool&) = delete;
+
   // 析構函數會等待所有工作完成
   ~ThreadPool() {
     {
-      std::unique_lock<std::mutex> lock(queue_mutex);
+      std::unique_lock<std::mutex> lock(sleepMutex);
       stop = true;
     }
-    condition.notify_all();
+    sleepCondition.notify_all();
     for (std::thread& worker : workers) worker.join();
   }
 
+  size_t size() const { return workers.size(); }
+
+  // 新增任務到線程池，用 future 取得結果
+  template <class F, class... Args>
+  auto enqueue(F&& f, Args&&... args)
+      -> std::future<std::invoke_result_t<F, Args...>> {
+    using return_type = std::invoke_result_t<F, Args...>;
+
+    std::packaged_task<return_type()> task(
+        [f = std::forward<F>(f),
+         args = std::make_tuple(std::forward<Args>(args)...)]() mutable {
+          return std::apply(f, args);
+        });
+
+    std::future<return_type> res = task.get_future();
+    submit(Task(std::move(task)));
+    return res;
+  }
+
+  // 送出一個不需要回傳值的任務
+  void submit(Task task) {
+    if (stop) throw std::runtime_error("enqueue on stopped ThreadPool");
+
+    size_t index = currentIndex();
+    if (index == NO_WORKER) {
+      index = nextQueue.fetch_add(1, std::memory_order_relaxed) % queueCount;
+    }
+    // 先加計數再放進佇列，計數才不會比佇列裡的任務少
+    pending.fetch_add(1);
+    {
+      std::lock_guard<std::mutex> lock(queues[index].mutex);
+      queues[index].tasks.push_back(std::move(task));
+    }
+
+    // 有線程在睡才需要叫醒，大部分時候不用碰 sleepMutex
+    if (sleepers.load() > 0) {
+      { std::lock_guard<std::mutex> lock(sleepMutex); }
+      sleepCondition.notify_one();
+    }
+  }
+
+  // 拿一個還沒執行的任務來跑，沒有任務時回傳 false；等待中的線程用它幫忙
+  bool runPendingTask() {
+    Task task;
+    if (!popTask(currentIndex(), task)) return false;
+    task();
+    return true;
+  }
+
+  // 對 [begin, end) 每個 i 呼叫 body(i)，每 grain 個一組分給工作線程
+  template <class F>
+  void parallel_for(size_t begin, size_t end, size_t grain, F&& body);
+
+  // 每組依序用 combine 合併 map(i) 的結果，再依組別順序合併，
+  // 所以同樣的輸入一定得到同樣的結果
+  template <class T, class Map, class Combine>
+  T parallel_reduce(size_t begin, size_t end, size_t grain, T identity,
+                    Map&& map, Combine&& combine);
+
+  // 設定共用線程池，必須在第一次呼叫 shared() 之前；threads 為 0 表示跟
+  // CPU 核心數一樣
+  static void configureShared(size_t threads, bool pinThreads = false) {
+    sharedOptions().threads = threads;
+    sharedOptions().pinThreads = pinThreads;
+  }
+
+  // 整個程式共用的線程池，第一次使用時建立，程式結束時才收掉
+  static ThreadPool& shared() {
+    static ThreadPool pool(
+        sharedOptions().threads > 0 ? sharedOptions().threads : defaultSize(),
+        sharedOptions().pinThreads);
+    return pool;
+  }
+
  private:
+  static constexpr size_t NO_WORKER = static_cast<size_t>(-1);
+
+  // 每條工作線程的佇列，各自一把鎖，對齊 cache line 避免 false sharing
+  struct alignas(64) WorkQueue {
+    std::mutex mutex;
+    std::deque<Task> tasks;
+  };
+
+  struct Options {
+    size_t threads = 0;
+    bool pinThreads = false;
+  };
+
+  struct WorkerSlot {
+    const ThreadPool* pool = nullptr;
+    size_t index = NO_WORKER;
+  };
+
+  static WorkerSlot& currentWorker() {
+    static thread_local WorkerSlot slot;
+    return slot;
+  }
+
+  // 目前的線程在這個線程池裡的編號，不是這個線程池的工作線程時為 NO_WORKER
+  size_t currentIndex() const {
+    const WorkerSlot& slot = currentWorker();
+    return slot.pool == this ? slot.index : NO_WORKER;
+  }
+
+  void workerLoop(size_t index) {
+    currentWorker() = WorkerSlot{this, index};
+
+    while (true) {
+      Task task;
+      if (popTask(index, task)) {
+        task();
+        continue;
+      }
+
+      std::unique_lock<std::mutex> lock(sleepMutex);
+      sleepers.fetch_add(1);
+      sleepCondition.wait(lock, [this] { return stop || pending.load() > 0; });
+      sleepers.fetch_sub(1);
+
+      if (stop && pending.load() == 0) return;
+    }
+  }
+
+  // 先拿自己佇列尾端的任務，沒有再從其他佇列前端偷
+  bool popTask(size_t index, Task& task) {
+    if (pending.load() == 0) return false;
+
+    if (index != NO_WORKER) {
+      WorkQueue& own = queues[index];
+      std::lock_guard<std::mutex> lock(own.mutex);
+      if (!own.tasks.empty()) {
+        task = std::move(own.tasks.back());
+        own.tasks.pop_back();
+        pending.fetch_sub(1);
+        return true;
+      }
+    }
+
+    size_t start = index == NO_WORKER ? 0 : index + 1;
+    for (size_t i = 0; i < queueCount; ++i) {
+      WorkQueue& victim = queues[(start + i) % queueCount];
+      std::unique_lock<std::mutex> lock(victim.mutex, std::try_to_lock);
+      if (!lock.owns_lock() || victim.tasks.empty()) continue;
+      task = std::move(victim.tasks.front());
+      victim.tasks.pop_front();
+      pending.fetch_sub(1);
+      return true;
+    }
+    return false;
+  }
+
+  static Options& sharedOptions() {
+    static Options options;
+    return options;
+  }
+
+  static size_t defaultSize() {
+    unsigned int cores = std::thread::hardware_concurrency();
+    return cores > 0 ? cores : 4;  // 如果無法檢測，預設為4
+  }
+
+  static void pinToCore(std::thread& thread, size_t index) {
+#ifdef __linux__
+    cpu_set_t cpus;
+    CPU_ZERO(&cpus);
+    CPU_SET(index % defaultSize(), &cpus);
+    pthread_setaffinity_np(thread.native_handle(), sizeof(cpus), &cpus);
+#else
+    // 其他平台不綁定核心，交給系統排程
+    (void)thread;
+    (void)index;
+#endif
+  }
+
   // 工作線程向量
   std::vector<std::thread> workers;
-  // 任務隊列
-  std::queue<std::function<void()>> tasks;
-
-  // 同步
-  std::mutex queue_mutex;
-  std::condition_variable condition;
-  bool stop = false;
-};
\ No newline at end of file
+  // 每條工作線程一個任務佇列
+  std::unique_ptr<WorkQueue[]> queues;
+  size_t queueCount;
+  // 外部線程送出的任務輪流放進各個佇列
+  std::atomic<size_t> nextQueue{0};
+
+  // 還沒被拿走的任務數
+  std::atomic<size_t> pending{0};
+
+  // 同步：只有沒事做的線程才會睡在這裡
+  std::atomic<size_t> sleepers{0};
+  std::mutex sleepMutex;
+  std::condition_variable sleepCondition;
+  std::atomic<bool> stop{false};
+};
+
+// 一組 fork/join 任務。wait 時呼叫的線程會幫忙執行線程池裡的任務，
+// 所以工作線程裡也可以再開一組任務等待，不會卡死。
+class TaskGroup {
+ public:
+  explicit TaskGroup(ThreadPool& pool = ThreadPool::shared()) : _pool(pool) {}
+
+  TaskGroup(const TaskGroup&) = delete;
+  TaskGroup& operator=(const TaskGroup&) = delete;
+
+  ~TaskGroup() {
+    // 解構時不能丟例外，只等任務結束
+    while (_pending.load(std::memory_order_acquire) > 0) help();
+  }
+
+  template <class F>
+  void run(F&& f) {
+    _pending.fetch_add(1, std::memory_order_relaxed);
+    _pool.submit([this, f = std::forward<F>(f)]() mutable {
+      try {
+        f();
+      } catch (...) {
+        std::lock_guard<std::mutex> lock(_errorMutex);
+        if (!_error) _error = std::current_exception();
+      }
+      _pending.fetch_sub(1, std::memory_order_release);
+    });
+  }
+
+  // 等所有任務完成，任務丟出的第一個例外會在這裡重新丟出
+  void wait() {
+    while (_pending.load(std::memory_order_acquire) > 0) help();
+
+    if (_error) {
+      std::exception_ptr error = _error;
+      _error = nullptr;
+      std::rethrow_exception(error);
+    }
+  }
+
+ private:
+  void help() {
+    if (!_pool.runPendingTask()) std::this_thread::yield();
+  }
+
+  ThreadPool& _pool;
+  std::atomic<int> _pending{0};
+  std::mutex _errorMutex;
+  std::exception_ptr _error;
+};
+
+template <class F>
+void ThreadPool::parallel_for(size_t begin, size_t end, size_t grain,
+                              F&& body) {
+  if (begin >= end) return;
+  if (grain == 0) grain = 1;
+
+  TaskGroup group(*this);
+  // 第一組留給呼叫的線程自己跑
+  for (size_t chunk = begin + grain; chunk < end; chunk += grain) {
+    size_t chunkEnd = std::min(chunk + grain, end);
+    group.run([&body, chunk, chunkEnd] {
+      for (size_t i = chunk; i < chunkEnd; ++i) body(i);
+    });
+  }
+  for (size_t i = begin; i < std::min(begin + grain, end); ++i) body(i);
+  group.wait();
+}
+
+template <class T, class Map, class Combine>
+T ThreadPool::parallel_reduce(size_t begin, size_t end, size_t grain,
+                              T identity, Map&& map, Combine&& combine) {
+  if (begin >= end) return identity;
+  if (grain == 0) grain = 1;
+
+  size_t chunks = (end - begin + grain - 1) / grain;
+  std::vector<T> partials(chunks, identity);
+
+  parallel_for(0, chunks, 1, [&](size_t chunk) {
+    size_t chunkBegin = begin + chunk * grain;
+    size_t chunkEnd = std::min(chunkBegin + grain, end);
+    T result = identity;
+    for (size_t i = chunkBegin; i < chunkEnd; ++i) {
+      result = combine(result, map(i));
+    }
+    partials[chunk] = result;
+  });
+
+  T result = identity;
+  for (const T& partial : partials) result = combine(result, partial);
+  return result;
+}
@@ -1,71 +1,156 @@
 #include "ai_operation.h"
 
+#include <algorithm>
 #include <chrono>
 #include <thread>
 
-#include "game.h"
 #include "mcts.h"
 const int sleepTime = 2000;
 
+// 沒有另外設定搜尋限制時每次決策的迭代次數
 const int simulations = 5000;
 
-AIOperation::AIOperation() {}
+AIOperation::AIOperation()
+    : AIOperation(Xoshiro256::randomSeed(), ThreadPool::shared(), 0,
+                  &DecisionCache::shared()) {}
+
+AIOperation::AIOperation(std::uint64_t seed)
+    : AIOperation(seed, ThreadPool::shared()) {}
+
+AIOperation::AIOperation(std::uint64_t seed, ThreadPool& pool,
+                         int searchThreads, DecisionCache* cache)
+    : _seeder(seed),
+      _pool(&pool),
+      _searchThreads(searchThreads),
+      _cache(cache),
+      _insured(false),
+      _statsLog(nullptr) {
+  _limits.iterations = simulations;
+  // 大部分的決策很明顯，最好的動作分開就不用把迭代跑完
+  _limits.confidence = 0.95;
+}
 
-bool AIOperation::hit(std::vector<Poker> playerCards,
-                      std::vector<Poker> dealerVisibleCards,
-                      std::vector<Poker> cardPool) {
-  auto mctsEngine =
-      mcts::MCTS(simulations, playerCards, cardPool, dealerVisibleCards);
+void AIOperation::_recordStats(const mcts::MCTS& search) {
+  _lastStats = search.stats();
+  if (_statsLog != nullptr) *_statsLog << _lastStats.toJson() << std::endl;
+}
 
-  auto bestNode = mctsEngine.run();
+mcts::Config AIOperation::_searchConfig() {
+  mcts::Config config;
+  config.seed = _seeder();
+  config.pool = _pool;
+  config.threads = _searchThreads;
+  return config;
+}
 
-  if (bestNode->action == mcts::Action::HIT) {
-    return true;
-  } else {
-    return false;
+mcts::MCTS& AIOperation::_search(const DecisionContext& context) {
+  CardSpan playerCards = context.hand;
+  bool samePrefix =
+      _session != nullptr && playerCards.size() >= _sessionCards.size() &&
+      std::equal(_sessionCards.begin(), _sessionCards.end(),
+                 playerCards.begin());
+
+  if (samePrefix && playerCards.size() == _sessionCards.size()) {
+    // 同一個狀態的另一個決策，直接讀同一棵樹
+    _session->updateShoe(context.unseen);
+    return *_session;
+  }
+
+  if (samePrefix && playerCards.size() == _sessionCards.size() + 1) {
+    // 實際拿到一張牌，對應的子樹變成新的根節點，再補足搜尋次數
+    _session->advance(playerCards.back());
+    _session->updateShoe(context.unseen);
+    _sessionCards.push_back(playerCards.back());
+
+    // 迭代次數扣掉子樹已有的訪問次數，時間和其他預算每次決策重新算
+    mcts::SearchLimits limits = _limits;
+    if (limits.iterations >= 0) {
+      int visits = _session->node(_session->root).visits;
+      limits.iterations = std::max(0, limits.iterations - visits);
+    }
+    _session->search(limits);
+    _recordStats(*_session);
+    return *_session;
   }
+
+  _session = std::make_unique<mcts::MCTS>(
+      simulations, HandState::of(playerCards), context.unseen,
+      context.dealerVisible, _searchConfig());
+  _sessionCards = playerCards.toVector();
+  // 這一手已經買了保險(例如保險的決策命中快取)，新的樹也要從買了保險的狀態開始
+  if (_insured) _session->advance(mcts::Action::INSURANCE);
+  _session->search(_limits);
+  _recordStats(*_session);
+  return *_session;
 }
 
-std::map<std::string, bool> AIOperation::doubleOrSurrender(
-    std::vector<Poker> playerCards, std::vector<Poker> dealerVisibleCards,
-    std::vector<Poker> cardPool) {
-  std::map<std::string, bool> result;
+mcts::ActionTable AIOperation::_evaluate(const DecisionContext& context) {
+  if (_cache == nullptr) return _search(context).actionTable();
 
-  auto mctsEngine =
-      mcts::MCTS(simulations, playerCards, cardPool, dealerVisibleCards);
+  DecisionCache::Key key = _cache->keyOf(
+      HandState::of(context.hand),
+      RANK_POINT[context.dealerVisible.front().getRank()], _insured,
+      context.unseen);
 
-  auto bestNode = mctsEngine.run();
+  mcts::ActionTable table;
+  if (_cache->find(key, table)) return table;
 
-  if (bestNode->action == mcts::Action::DOUBLE) {
-    result["double"] = true;
-  } else if (bestNode->action == mcts::Action::SURRENDER) {
-    result["surrender"] = true;
-  } else {
-    result["double"] = false;
-    result["surrender"] = false;
+  const mcts::MCTS& search = _search(context);
+  table = search.actionTable();
+  // 時間到才停下的搜尋沒有用完預算，不存進快取，免得被當成完整的結果給
+  // 其他呼叫端用(例如真人牌桌上限時的 AI 和 simulate 共用同一個快取)
+  if (search.stats().stopReason != StopReason::TIME) {
+    _cache->insert(key, table);
   }
-  return result;
+  return table;
 }
 
-bool AIOperation::insurance(std::vector<Poker> playerCards,
-                            std::vector<Poker> dealerVisibleCards,
-                            std::vector<Poker> cardPool) {
-  auto mctsEngine =
-      mcts::MCTS(simulations, playerCards, cardPool, dealerVisibleCards);
+bool AIOperation::hit(const DecisionContext& context) {
+  return mcts::bestAction(_evaluate(context),
+                          {mcts::Action::HIT, mcts::Action::STAND}) ==
+         mcts::Action::HIT;
+}
 
-  auto bestNode = mctsEngine.run();
+OpeningDecision AIOperation::doubleOrSurrender(const DecisionContext& context) {
+  mcts::Action best = mcts::bestAction(
+      _evaluate(context),
+      {mcts::Action::HIT, mcts::Action::STAND, mcts::Action::DOUBLE,
+       mcts::Action::SURRENDER, mcts::Action::INSURANCE});
+
+  if (best == mcts::Action::DOUBLE) {
+    return OpeningDecision::DOUBLE;
+  } else if (best == mcts::Action::SURRENDER) {
+    return OpeningDecision::SURRENDER;
+  }
+  return OpeningDecision::NOTHING;
+}
 
-  if (bestNode->action == mcts::Action::INSURANCE) {
+bool AIOperation::insurance(const DecisionContext& context) {
+  if (mcts::bestAction(_evaluate(context),
+                       {mcts::Action::HIT, mcts::Action::STAND,
+                        mcts::Action::INSURANCE}) == mcts::Action::INSURANCE) {
+    _insured = true;
+    // 之後的要牌決策都在買了保險的子樹裡繼續；命中快取時沒有對應的搜尋樹，
+    // 就留給下一次決策重新搜尋，_search 建新樹時會補上保險
+    bool sameCards =
+        _session != nullptr &&
+        std::equal(_sessionCards.begin(), _sessionCards.end(),
+                   context.hand.begin(), context.hand.end());
+    if (sameCards) {
+      _session->advance(mcts::Action::INSURANCE);
+    } else {
+      _session.reset();
+    }
     return true;
   } else {
     return false;
   }
 }
 
-int AIOperation::stake(int, std::vector<Poker> dealerVisibleCards,
-                       std::vector<Poker> cardPool) {
-  Game game = Game::getInstance();
-  int leastBet = game.getLeasetBet();
+int AIOperation::stake(const DecisionContext& context) {
+  // 新的一手牌，之前的搜尋不再適用
+  _session.reset();
+  _insured = false;
 
-  return leastBet;
+  return context.table.leastBet;
 }
@@ -0,0 +1,93 @@
+#include "card_art.h"
+
+#include <array>
+
+namespace {
+
+const int BODY_ROWS = 18;
+
+const char* const SPADE_BODY[BODY_ROWS] = {
+    "|       *       |", "|      ***      |", "|     *****     |",
+    "|    *******    |", "|   *********   |", "|  ***********  |",
+    "| ************* |", "|***************|", "|***************|",
+    "|***************|", "|***************|", "| ************* |",
+    "|  ***********  |", "|   *** * ***   |", "|       *       |",
+    "|      ***      |", "|     *****     |", "|    *******    |",
+};
+
+const char* const HEART_BODY[BODY_ROWS] = {
+    "|               |", "|   ***   ***   |", "|  ***** *****  |",
+    "| ************* |", "|***************|", "|***************|",
+    "|***************|", "| ************* |", "| ************* |",
+    "|  ***********  |", "|  ***********  |", "|   *********   |",
+    "|   *********   |", "|    *******    |", "|     *****     |",
+    "|     *****     |", "|      ***      |", "|       *       |",
+};
+
+const char* const DIAMOND_BODY[BODY_ROWS] = {
+    "|               |", "|               |", "|       *       |",
+    "|      ***      |", "|     *****     |", "|    *******    |",
+    "|   *********   |", "|  ***********  |", "| ************* |",
+    "|***************|", "| ************* |", "|  ***********  |",
+    "|   *********   |", "|    *******    |", "|     *****     |",
+    "|      ***      |", "|       *       |", "|               |",
+};
+
+const char* const CLUB_BODY[BODY_ROWS] = {
+    "|               |", "|      ***      |", "|     *****     |",
+    "|     *****     |", "|    *******    |", "|    *******    |",
+    "|     *****     |", "|      ***      |", "|   **  *  **   |",
+    "| ***** * ***** |", "|***************|", "|***************|",
+    "|***************|", "| ***** * ***** |", "|   **  *  **   |",
+    "|      ***      |", "|     *****     |", "|    *******    |",
+};
+
+const char* const* const BODIES[4] = {SPADE_BODY, HEART_BODY, DIAMOND_BODY,
+                                      CLUB_BODY};
+
+const char* const EDGE = "-----------------";
+
+std::vector<std::string> buildFront(Suit suit, int rank) {
+  std::string number = Poker(suit, rank).getNumber();
+  std::vector<std::string> picture;
+  picture.reserve(BODY_ROWS + 4);
+
+  picture.push_back(EDGE);
+  picture.push_back(number == "10" ? "|10             |"
+                                   : "|" + number + "              |");
+  for (int i = 0; i < BODY_ROWS; i++) {
+    picture.push_back(BODIES[suit][i]);
+  }
+  picture.push_back(number == "10" ? "|             10|"
+                                   : "|              " + number + "|");
+  picture.push_back(EDGE);
+  return picture;
+}
+
+}  // namespace
+
+const std::vector<std::string>& card_art::front(Suit suit, int rank) {
+  // 4 種花色 x 13 種點數，只建立一次
+  static const std::array<std::vector<std::string>, 52> table = [] {
+    std::array<std::vector<std::string>, 52> pictures;
+    for (int s = 0; s < 4; s++) {
+      for (int r = 1; r <= 13; r++) {
+        pictures[s * 13 + (r - 1)] = buildFront(static_cast<Suit>(s), r);
+      }
+    }
+    return pictures;
+  }();
+
+  return table[suit * 13 + (rank - 1)];
+}
+
+const std::vector<std::string>& card_art::back() {
+  static const std::vector<std::string> pattern = [] {
+    std::vector<std::string> rows(BODY_ROWS + 4, "|***************|");
+    rows.front() = EDGE;
+    rows.back() = EDGE;
+    return rows;
+  }();
+
+  return pattern;
+}
@@ -1,28 +1,33 @@
 #include "dealer.h"
 
 #include <algorithm>
-#include <chrono>
 #include <random>
+#include <utility>
 
-void Dealer::shuffle(std::vector<Poker>& cardPool) {
-  unsigned seed = std::chrono::system_clock::now().time_since_epoch().count();
+void Dealer::shuffle(std::vector<Poker>& cardPool, Xoshiro256& rng) {
+  std::shuffle(cardPool.begin(), cardPool.end(), rng);
+}
 
-  std::shuffle(cardPool.begin(), cardPool.end(),
-               std::default_random_engine(seed));
+Poker Dealer::draw(std::vector<Poker>& cardPool, Xoshiro256& rng) {
+  // 隨機選一張換到最後面再取出
+  std::uniform_int_distribution<size_t> pick(0, cardPool.size() - 1);
+  std::swap(cardPool[pick(rng)], cardPool.back());
+  Poker poker = cardPool.back();
+  cardPool.pop_back();
+  return poker;
 }
 
-void Dealer::deal(std::vector<Player>& players, std::vector<Poker>& cardPool) {
+void Dealer::deal(std::vector<Player>& players, std::vector<Poker>& cardPool,
+                  Xoshiro256& rng) {
   for (auto& player : players) {
-    player.addPoker(cardPool.back());
-    cardPool.pop_back();
+    player.addPoker(draw(cardPool, rng));
   }
 }
 
-void Dealer::deal(Player& banker, std::vector<Poker>& cardPool, bool needFlip) {
+void Dealer::deal(Player& banker, std::vector<Poker>& cardPool, bool needFlip,
+                  Xoshiro256& rng) {
   // get the card
-  Poker poker = cardPool.back();
-  // pop the last card from pool
-  cardPool.pop_back();
+  Poker poker = draw(cardPool, rng);
   if (needFlip) {
     poker.flipTheCard();
   }
@@ -33,4 +38,4 @@ void Dealer::reduceCard(std::vector<Player>& players) {
   for (auto& player : players) {
     player.getPokers().clear();
   }
-}
\ No newline at end of file
+}
@@ -0,0 +1,69 @@
+#include "dealer_odds.h"
+
+DealerOdds::DealerOdds(std::size_t maxEntries) : _maxEntries(maxEntries) {}
+
+DealerOdds& DealerOdds::threadLocal() {
+  thread_local DealerOdds odds;
+  return odds;
+}
+
+const DealerDistribution& DealerOdds::distribution(int upcard,
+                                                    const Shoe& shoe) {
+  Key key{upcard, shoe};
+  auto it = _cache.find(key);
+  if (it != _cache.end()) return it->second;
+
+  if (_cache.size() >= _maxEntries) _cache.clear();
+
+  HandState hand;
+  hand.addPoint(upcard);
+  Shoe remaining = shoe;
+  std::unordered_map<std::uint64_t, DealerDistribution> memo;
+
+  return _cache.emplace(key, _solve(hand, remaining, 0, memo)).first->second;
+}
+
+DealerDistribution DealerOdds::_solve(
+    const HandState& hand, Shoe& shoe, std::uint64_t drawn,
+    std::unordered_map<std::uint64_t, DealerDistribution>& memo) {
+  DealerDistribution result{};
+
+  // 莊家停牌(或牌用完)
+  if (!hand.dealerShouldHit() || shoe.empty()) {
+    if (hand.isBlackjack()) {
+      result[DEALER_BLACKJACK] = 1;
+    } else if (hand.isBust()) {
+      result[DEALER_BUST] = 1;
+    } else {
+      // 牌用完時不足17點的情況極少見，當作17點處理
+      int total = hand.total() < 17 ? 17 : hand.total();
+      result[DEALER_17 + total - 17] = 1;
+    }
+    return result;
+  }
+
+  auto it = memo.find(drawn);
+  if (it != memo.end()) return it->second;
+
+  const double size = shoe.size();
+  for (int point = 1; point <= Shoe::POINTS; point++) {
+    int count = shoe.count(point);
+    if (count == 0) continue;
+
+    HandState next = hand;
+    next.addPoint(point);
+    shoe.remove(point);
+    // 每個點數用 4 bits 記錄已抽出的張數
+    DealerDistribution sub =
+        _solve(next, shoe, drawn + (1ULL << (4 * (point - 1))), memo);
+    shoe.add(point);
+
+    double probability = count / size;
+    for (int i = 0; i < DEALER_RESULTS; i++) {
+      result[i] += probability * sub[i];
+    }
+  }
+
+  memo.emplace(drawn, result);
+  return result;
+}
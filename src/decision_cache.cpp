@@ -0,0 +1,115 @@
+#include "decision_cache.h"
+
+#include <algorithm>
+
+DecisionCache::DecisionCache(const DecisionCacheConfig& config)
+    : _config(config),
+      _hits(0),
+      _misses(0),
+      _insertions(0),
+      _evictions(0) {
+  // 分片數不超過容量，每個分片至少放得下一個狀態，總數也不會超過容量
+  _config.capacity = std::max<std::size_t>(1, _config.capacity);
+  _config.shards = static_cast<int>(std::min<std::size_t>(
+      std::max(1, _config.shards), _config.capacity));
+  _config.shoeBucket = std::max(1, _config.shoeBucket);
+  _shardCapacity = _config.capacity / _config.shards;
+  _shards = std::make_unique<Shard[]>(_config.shards);
+}
+
+DecisionCache& DecisionCache::shared() {
+  static DecisionCache cache;
+  return cache;
+}
+
+DecisionCache::Key DecisionCache::keyOf(const HandState& hand, int upcard,
+                                        bool insured,
+                                        const Shoe& unseen) const {
+  Key key;
+  key.state = static_cast<std::uint64_t>(hand.hardTotal) |
+              static_cast<std::uint64_t>(hand.softAces) << 8 |
+              static_cast<std::uint64_t>(hand.cardCount) << 16 |
+              static_cast<std::uint64_t>(hand.flags) << 24 |
+              static_cast<std::uint64_t>(upcard) << 32 |
+              static_cast<std::uint64_t>(insured) << 40;
+
+  std::uint64_t h = 0xCBF29CE484222325ULL ^ key.state;
+  h *= 0x100000001B3ULL;
+  for (int point = 1; point <= Shoe::POINTS; point++) {
+    key.shoe[point - 1] = unseen.count(point) / _config.shoeBucket;
+    h ^= key.shoe[point - 1];
+    h *= 0x100000001B3ULL;
+  }
+  key.hash = h;
+  return key;
+}
+
+DecisionCache::Shard& DecisionCache::_shardOf(const Key& key) const {
+  // 低位元給 unordered_map 用，分片取高位元
+  return _shards[(key.hash >> 48) % _config.shards];
+}
+
+bool DecisionCache::find(const Key& key, mcts::ActionTable& table) {
+  Shard& shard = _shardOf(key);
+  std::lock_guard<std::mutex> lock(shard.mutex);
+
+  auto it = shard.index.find(key);
+  if (it == shard.index.end()) {
+    _misses.fetch_add(1, std::memory_order_relaxed);
+    return false;
+  }
+
+  shard.lru.splice(shard.lru.begin(), shard.lru, it->second);
+  table = it->second->table;
+  _hits.fetch_add(1, std::memory_order_relaxed);
+  return true;
+}
+
+void DecisionCache::insert(const Key& key, const mcts::ActionTable& table) {
+  Shard& shard = _shardOf(key);
+  std::lock_guard<std::mutex> lock(shard.mutex);
+
+  auto it = shard.index.find(key);
+  if (it != shard.index.end()) {
+    // 別的執行緒先搜完同一個狀態，用新的結果覆蓋
+    it->second->table = table;
+    shard.lru.splice(shard.lru.begin(), shard.lru, it->second);
+    return;
+  }
+
+  if (shard.lru.size() >= _shardCapacity) {
+    shard.index.erase(shard.lru.back().key);
+    shard.lru.pop_back();
+    _evictions.fetch_add(1, std::memory_order_relaxed);
+  }
+
+  shard.lru.push_front(Entry{key, table});
+  shard.index.emplace(key, shard.lru.begin());
+  _insertions.fetch_add(1, std::memory_order_relaxed);
+}
+
+DecisionCache::Stats DecisionCache::stats() const {
+  Stats stats;
+  stats.hits = _hits.load(std::memory_order_relaxed);
+  stats.misses = _misses.load(std::memory_order_relaxed);
+  stats.insertions = _insertions.load(std::memory_order_relaxed);
+  stats.evictions = _evictions.load(std::memory_order_relaxed);
+  return stats;
+}
+
+std::size_t DecisionCache::size() const {
+  std::size_t total = 0;
+  for (int i = 0; i < _config.shards; i++) {
+    std::lock_guard<std::mutex> lock(_shards[i].mutex);
+    total += _shards[i].lru.size();
+  }
+  return total;
+}
+
+void DecisionCache::clear() {
+  for (int i = 0; i < _config.shards; i++) {
+    std::lock_guard<std::mutex> lock(_shards[i].mutex);
+    _shards[i].lru.clear();
+    _shards[i].index.clear();
+  }
+}
@@ -0,0 +1,35 @@
+#include "exact_operation.h"
+
+#include <algorithm>
+
+OpeningDecision ExactOperation::doubleOrSurrender(
+    const DecisionContext& context) {
+  HandState hand = HandState::of(context.hand);
+  int upcard = RANK_POINT[context.dealerVisible[0].getRank()];
+  ActionValues values = _solver.evaluate(hand, upcard, context.unseen);
+
+  double play = std::max(values.stand, values.hit);
+  if (values.doubleDown > play && values.doubleDown >= values.surrender) {
+    return OpeningDecision::DOUBLE;
+  } else if (values.surrender > play) {
+    return OpeningDecision::SURRENDER;
+  }
+  return OpeningDecision::NOTHING;
+}
+
+bool ExactOperation::hit(const DecisionContext& context) {
+  HandState hand = HandState::of(context.hand);
+  int upcard = RANK_POINT[context.dealerVisible[0].getRank()];
+
+  return _solver.hit(hand, upcard, context.unseen) >
+         _solver.stand(hand, upcard, context.unseen);
+}
+
+bool ExactOperation::insurance(const DecisionContext& context) {
+  int upcard = RANK_POINT[context.dealerVisible[0].getRank()];
+  return _solver.insurance(upcard, context.unseen) > 0;
+}
+
+int ExactOperation::stake(const DecisionContext& context) {
+  return context.table.leastBet;
+}
@@ -0,0 +1,110 @@
+#include "exact_solver.h"
+
+#include <algorithm>
+
+ExactSolver::ExactSolver(std::size_t maxEntries) : _maxEntries(maxEntries) {}
+
+ActionValues ExactSolver::evaluate(const HandState& hand, int upcard,
+                                   const Shoe& shoe) {
+  ActionValues values;
+  values.stand = stand(hand, upcard, shoe);
+  values.hit = hit(hand, upcard, shoe);
+  values.doubleDown = doubleDown(hand, upcard, shoe);
+  values.surrender = -0.5;
+  values.insurance = insurance(upcard, shoe);
+  return values;
+}
+
+double ExactSolver::stand(const HandState& hand, int upcard,
+                          const Shoe& shoe) {
+  // 特殊牌型不管莊家拿到什麼都贏 2 倍
+  if (hand.isFiveCardCharlie() || hand.isShun()) return 2;
+  if (hand.isBust()) return -1;
+
+  const DealerDistribution& odds = _dealerOdds.distribution(upcard, shoe);
+
+  // 莊家爆牌時只賠 1 倍(黑傑克也一樣)
+  double value = odds[DEALER_BUST];
+  int total = hand.total();
+  for (int r = DEALER_17; r <= DEALER_21; r++) {
+    int dealerTotal = 17 + r;
+    if (hand.isBlackjack()) {
+      value += 1.5 * odds[r];
+    } else if (total > dealerTotal) {
+      value += odds[r];
+    } else if (total < dealerTotal) {
+      value -= odds[r];
+    }
+  }
+  // 莊家黑傑克以 21 點比較，玩家黑傑克或 21 點都是平手
+  if (total < 21) value -= odds[DEALER_BLACKJACK];
+
+  return value;
+}
+
+double ExactSolver::hit(const HandState& hand, int upcard, const Shoe& shoe) {
+  if (shoe.empty()) return stand(hand, upcard, shoe);
+
+  double value = 0;
+  Shoe remaining = shoe;
+  for (int point = 1; point <= Shoe::POINTS; point++) {
+    int count = shoe.count(point);
+    if (count == 0) continue;
+
+    HandState next = hand;
+    next.addPoint(point);
+    remaining.remove(point);
+    value += static_cast<double>(count) / shoe.size() *
+             _best(next, upcard, remaining);
+    remaining.add(point);
+  }
+  return value;
+}
+
+double ExactSolver::doubleDown(const HandState& hand, int upcard,
+                               const Shoe& shoe) {
+  if (shoe.empty()) return 2 * stand(hand, upcard, shoe);
+
+  // 加倍後只拿一張牌，賭注變兩倍
+  double value = 0;
+  Shoe remaining = shoe;
+  for (int point = 1; point <= Shoe::POINTS; point++) {
+    int count = shoe.count(point);
+    if (count == 0) continue;
+
+    HandState next = hand;
+    next.addPoint(point);
+    remaining.remove(point);
+    value += static_cast<double>(count) / shoe.size() *
+             stand(next, upcard, remaining);
+    remaining.add(point);
+  }
+  return 2 * value;
+}
+
+double ExactSolver::insurance(int upcard, const Shoe& shoe) const {
+  if (upcard != 1 || shoe.empty()) return -0.5;
+
+  // 付半倍賭注，莊家黑傑克時拿回一倍
+  double blackjack = static_cast<double>(shoe.count(10)) / shoe.size();
+  return blackjack * 1 - (1 - blackjack) * 0.5;
+}
+
+double ExactSolver::_best(const HandState& hand, int upcard,
+                          const Shoe& shoe) {
+  if (hand.isBust()) return -1;
+  // 21 點時不能再要牌，五張牌查理直接停牌最好
+  if (hand.total() == 21 || hand.isFiveCardCharlie()) {
+    return stand(hand, upcard, shoe);
+  }
+
+  Key key{hand, upcard, shoe};
+  auto it = _cache.find(key);
+  if (it != _cache.end()) return it->second;
+
+  double value = std::max(stand(hand, upcard, shoe), hit(hand, upcard, shoe));
+
+  if (_cache.size() >= _maxEntries) _cache.clear();
+  _cache.emplace(key, value);
+  return value;
+}
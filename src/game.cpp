@@ -2,179 +2,221 @@
 
 #include <algorithm>
 #include <chrono>
-#include <fstream>
+#include <exception>
 #include <iostream>
 #include <thread>
 
 #include "default_operation.h"
-#define DEFAULT "\033[0;1m"
-#define REDBACKGROUND "\033[41;1m"
-#define GREENBACKGROUND "\033[42;1m"
+#include "table_operation.h"
 
 const int sleepTime = 1000;
 
-// make it singleton
-Game *Game::_instance = nullptr;
-Game &Game::getInstance() {
-  if (_instance == nullptr) {
-    _instance = new Game();
-  }
-  return *_instance;
-}
 // constructor
-Game::Game() : _banker(nullptr), _leastBet(1000), _isRunning(true) {}
-
-// game start
-void Game::start(bool isTestMode) {
-  if (isTestMode) {
-    int wins = 0;
-    int losses = 0;
-    int draws = 0;
-    int totalGames = 10000;
-    int totalProfit = 0;
+Game::Game(const GameConfig &config, Renderer &renderer)
+    : _config(config),
+      _table{config.leastBet, config.decks},
+      _renderer(&renderer),
+      _isRunning(true),
+      _rounds(config.rounds),
+      _currentRound(0),
+      _playerCount(config.seats),
+      _banker(nullptr),
+      _rng(config.seed),
+      _strategyTable(_openStrategyTable(config)) {}
+
+std::shared_ptr<const StrategyTable> Game::_openStrategyTable(
+    const GameConfig &config) {
+  if (config.strategyTable.empty()) return nullptr;
+  return std::make_shared<const StrategyTable>(config.strategyTable,
+                                               config.decks);
+}
 
-    Player defaultPlayer("Default", new DefaultOperation());
-    Player defaultPlayer2("Default2", new DefaultOperation());
-    Player aiPlayer("AI", new AIOperation());
+SimulationResult Game::simulate(const GameConfig &config,
+                                long long totalGames, int shards,
+                                ThreadPool &pool,
+                                std::atomic<long long> *progress) {
+  shards = std::max(1, shards);
+  std::atomic<long long> done(0);
+  std::atomic<long long> &counter = progress != nullptr ? *progress : done;
+
+  std::vector<SimulationResult> results(shards);
+
+  // 策略表只映射一次給所有分片共用，檔案有問題時在這裡就丟出例外
+  std::shared_ptr<const StrategyTable> table = _openStrategyTable(config);
+
+  TaskGroup group(pool);
+  for (int shard = 0; shard < shards; shard++) {
+    long long games = totalGames / shards + (shard < totalGames % shards);
+
+    group.run([&results, &counter, &config, &pool, &table, shard, games] {
+      // 每個分片的牌堆和 AI 各用一條串流
+      GameConfig shardConfig = config;
+      shardConfig.seed = Xoshiro256::forStream(config.seed, 2 * shard)();
+      shardConfig.strategyTable.clear();
+      Game game(shardConfig, NullRenderer::instance());
+
+      // 每個分片已經佔一條線程，AI 的搜尋就不再分出去。
+      // 快取也是每個分片一份，命中與否只跟這個分片的牌局有關，結果可以重現
+      DefaultOperation defaultOperation;
+      DefaultOperation defaultOperation2;
+      DecisionCache cache;
+      std::unique_ptr<Operation> aiOperation;
+      if (table != nullptr) {
+        aiOperation = std::make_unique<TableOperation>(*table);
+      } else {
+        aiOperation = std::make_unique<AIOperation>(
+            Xoshiro256::forStream(config.seed, 2 * shard + 1)(), pool, 1,
+            &cache);
+      }
 
-    _players.push_back(defaultPlayer);
-    _players.push_back(aiPlayer);
-    _players.push_back(defaultPlayer2);
+      game._players.push_back(Player("Default", &defaultOperation));
+      game._players.push_back(Player("AI", aiOperation.get()));
+      game._players.push_back(Player("Default2", &defaultOperation2));
 
-    std::cout << "testing mcts..." << std::endl;
-    std::cout << "[                                                  ] 0/"
-              << totalGames << " (0%)" << std::endl;
+      results[shard] = game._playTestGames(static_cast<int>(games), counter);
+      results[shard].cacheHits = cache.stats().hits;
+      results[shard].cacheMisses = cache.stats().misses;
+    });
+  }
+  group.wait();
 
-    std::streambuf *originalCoutBuffer = std::cout.rdbuf();
+  SimulationResult result;
+  for (const auto &shardResult : results) result.merge(shardResult);
+  return result;
+}
 
-    std::ofstream nullStream;
-    // nullStream.open("/dev/null");  // Unix系統
-    // 在Windows系統上用這個:
-    nullStream.open("NUL");
+SimulationResult Game::_playTestGames(int games,
+                                      std::atomic<long long> &progress) {
+  SimulationResult result;
 
-    // 重定向標準輸出到空設備
-    std::cout.rdbuf(nullStream.rdbuf());
+  for (int i = 0; i < games; i++) {
+    if (_players[0].getMoney() < 100000) {
+      _players[0].addMoney(99999999);
+    }
 
-    for (int i = 0; i < totalGames; i++) {
-      if (_players[0].getMoney() < 100000) {
-        _players[0].addMoney(99999999);
-      }
+    _init();
 
-      if (i % 10 == 0 || i == totalGames - 1) {
-        // 計算進度百分比
-        int percentage = (i * 100) / totalGames;
-
-        // 恢復標準輸出以顯示進度
-        std::cout.rdbuf(originalCoutBuffer);
-
-        // 繪製進度條
-        std::cout << "\r[";
-        for (int j = 0; j < 50; j++) {
-          if (j < percentage / 2)
-            std::cout << "=";
-          else if (j == percentage / 2)
-            std::cout << ">";
-          else
-            std::cout << " ";
-        }
-        std::cout << "] " << i << "/" << totalGames << " (" << percentage
-                  << "%)     ";
-        std::cout.flush();  // 確保立即顯示
+    // for the player 0 is banker
+    if (_banker != &_players[0]) {
+      _banker->_isBanker = false;
+      _banker = &_players[0];
+      _banker->_isBanker = true;
+    }
 
-        // 重新禁用輸出
-        std::cout.rdbuf(nullStream.rdbuf());
-      }
+    _dealOpeningCards();
+    _askForStake();
+    _askForDoubleOrSurrender();
+    _askInsuranceForAllPlayers();
+    _drawForAllPlayers();
+    _drawForBanker();
+    _settle();
+    Dealer::reduceCard(_players);
 
-      _init();
+    Player &aiPlayer = _players[1];
+    Player &defaultPlayer2 = _players[2];
 
-      // for the player 0 is banker
-      if(_banker != &_players[0]) {
-        _banker->_isBanker = false;
-        _banker = &_players[0];
-        _banker->_isBanker = true;
-      }
+    result.games++;
+    result.profit += aiPlayer.getProfit();
 
-      Dealer::shuffle(_cardPool);
-      Dealer::deal(_players, _cardPool);
-      Dealer::deal(_players, _cardPool);
-      _banker->getPokers()[1].flipTheCard();
-      _askForStake();
-      _askForDoubleOrSurrender();
-      _askInsuranceForAllPlayers();
-      _drawForAllPlayers();
-      _drawForBanker();
-      _settle();
-      Dealer::reduceCard(_players);
-
-      aiPlayer = _players[1];
-      defaultPlayer2 = _players[2];
-
-      totalProfit += aiPlayer.getProfit();
-
-      if (aiPlayer.getProfit() > defaultPlayer2.getProfit()) {
-        wins++;
-      } else if (aiPlayer.getProfit() < defaultPlayer2.getProfit()) {
-        losses++;
-      } else {
-        draws++;
-      }
+    if (aiPlayer.getProfit() > defaultPlayer2.getProfit()) {
+      result.wins++;
+    } else if (aiPlayer.getProfit() < defaultPlayer2.getProfit()) {
+      result.losses++;
+    } else {
+      result.draws++;
     }
 
-    // 恢復標準輸出
-    std::cout.rdbuf(originalCoutBuffer);
+    progress++;
+  }
 
-    totalGames -= draws;
+  return result;
+}
 
-    // show the result
-    std::cout << "\nMCTS winrate: " << (double)wins / totalGames * 100 << "%"
-              << std::endl;
+// game start
+void Game::start(bool isTestMode) {
+  if (isTestMode) {
+    long long totalGames = 10000;
+    int shards = static_cast<int>(ThreadPool::shared().size());
+
+    _renderer->message("testing mcts...");
+    _renderer->progress(0, totalGames);
+
+    std::atomic<long long> progress(0);
+    std::atomic<bool> finished(false);
+    SimulationResult result;
+    std::exception_ptr error;
+    std::thread simulation([&] {
+      try {
+        result = simulate(_config, totalGames, shards, ThreadPool::shared(),
+                          &progress);
+      } catch (...) {
+        error = std::current_exception();
+      }
+      finished = true;
+    });
+
+    // 分片在線程池裡跑，這裡只負責更新進度條
+    long long shown = 0;
+    while (!finished) {
+      std::this_thread::sleep_for(std::chrono::milliseconds(100));
+      if (progress.load() != shown) {
+        shown = progress.load();
+        _renderer->progress(shown, totalGames);
+      }
+    }
+    simulation.join();
+    if (error) std::rethrow_exception(error);
 
-    std::cout << "profit: " << totalProfit << std::endl;
+    _renderer->simulationResult(result);
     return;
   }
 
   // normal game start
-  std::cout << "Game start!"
-            << "\n";
+  _renderer->message("Game start!");
   // input the player count
-  _inputPlayerCount();
+  if (_playerCount == 0) _inputPlayerCount();
   // input the round count
-  _inputRoundCount();
+  if (_rounds == 0) _inputRoundCount();
 
-  std::cout << "What is your name?"
-            << "\n";
+  _renderer->message("What is your name?");
   std::string name;
   std::cin >> name;
   // create player
   _players.push_back(Player(name, new ManualOperation()));
 
   for (int i = 1; i < _playerCount; i++) {
+    Operation *operation;
+    if (_strategyTable != nullptr) {
+      operation = new TableOperation(*_strategyTable);
+    } else {
+      AIOperation *ai = new AIOperation();
+      mcts::SearchLimits limits = ai->searchLimits();
+      limits.timeLimit = _config.aiTimeLimit;
+      ai->setSearchLimits(limits);
+      operation = ai;
+    }
+
     _players.push_back(
-        Player("Player" + std::to_string(i + 1) + "(AI)", new AIOperation()));
+        Player("Player" + std::to_string(i + 1) + "(AI)", operation));
   }
 
   _currentRound = 0;
 
   // game start
   while (_rounds-- > 0 && _isRunning) {
-    std::cout << "Round " << ++_currentRound << " start!"
-              << "\n";
+    _renderer->roundStart(++_currentRound);
     // init every round
     _init();
     // tell the player the banker
-    std::cout << REDBACKGROUND << "*** The banker is " << _banker->getName()
-              << " ***" << DEFAULT << "\n";
+    _renderer->bankerChosen(*_banker);
     // ask every player to stake
     _askForStake();
-    //  shuffle the card
-    Dealer::shuffle(_cardPool);
-    std::cout << "Shuffling the card"
-              << "\n";
+    // the cards are drawn at random from the pool, so there is no need to
+    // shuffle the whole pool every round
+    _renderer->message("Shuffling the card");
     // deal the card to the players include banker
-    Dealer::deal(_players, _cardPool);
-    Dealer::deal(_players, _cardPool);
-    // fold the banker's second card
-    _banker->getPokers()[1].flipTheCard();
+    // deal two cards to everyone and fold the banker's second card
+    _dealOpeningCards();
     // show all card's to the player
     _showAllCard();
 
@@ -201,23 +243,21 @@ void Game::start(bool isTestMode) {
     _kickOut();
   }
 
-  std::cout << "Game end!"
-            << "\n";
+  _renderer->message("Game end!");
 
   _printFinalLeaderboard();
 }
 
 void Game::_inputPlayerCount() {
   std::string input;
-  std::cout << "How many players?(2-4)"
-            << "\n";
+  _renderer->message("How many players?(2-4)");
 
   while (true) {
     std::cin >> input;
     bool isNumber = true;
     for (auto element : input) {
       if (element > 57 || element < 48) {
-        std::cout << "Please enter valid number!\n";
+        _renderer->message("Please enter valid number!");
         isNumber = false;
         break;
       }
@@ -225,7 +265,7 @@ void Game::_inputPlayerCount() {
 
     if (isNumber) {
       if (std::stoi(input) < 2 || std::stoi(input) > 4) {
-        std::cout << "Please enter valid number!\n";
+        _renderer->message("Please enter valid number!");
         continue;
       } else {
         _playerCount = std::stoi(input);
@@ -238,15 +278,14 @@ void Game::_inputPlayerCount() {
 
 void Game::_inputRoundCount() {
   std::string input;
-  std::cout << "How many games do you want to play?"
-            << "\n";
+  _renderer->message("How many games do you want to play?");
 
   while (true) {
     std::cin >> input;
     bool isNumber = true;
     for (auto element : input) {
       if (element > 57 || element < 48) {
-        std::cout << "Please enter valid number!\n";
+        _renderer->message("Please enter valid number!");
         isNumber = false;
         break;
       }
@@ -260,31 +299,7 @@ void Game::_inputRoundCount() {
 // print the leaderboard
 void Game::_printLeaderboard() {
   _updateLeaderboard();
-  // change the color
-  std::cout << GREENBACKGROUND << "The result is:" << DEFAULT << "\n";
-
-  std::cout << _banker->getName() << "(banker)"
-            << "have : " << _banker->getMoney() << "dollars!\n"
-            << ((_banker->getProfit() > 0) ? GREENBACKGROUND : REDBACKGROUND)
-            << "(" << ((_banker->getProfit() > 0) ? "+" : "")
-            << _banker->getProfit() << ")" << DEFAULT << "\n";
-  for (auto player : _players) {
-    if (player._isBanker) continue;
-    if (player._isOut) continue;
-
-    std::cout << player.getName() << "have : " << player.getMoney()
-              << "dollars!\n"
-              << ((player.getProfit() > 0) ? GREENBACKGROUND : REDBACKGROUND)
-              << "(" << ((player.getProfit() > 0) ? "+" : "")
-              << player.getProfit() << ")" << DEFAULT << "\n";
-  }
-
-  std::cout << GREENBACKGROUND << "The leaderboard is:" << DEFAULT << "\n";
-  int i = 1;
-  for (auto player : _leaderboard) {
-    std::cout << i++ << ":\n"
-              << player.getName() << " Money: " << player.getMoney() << "\n";
-  }
+  _renderer->roundResult(*_banker, _players, _leaderboard);
 }
 // get the player list and sort it with the money then update the leaderboard
 void Game::_updateLeaderboard() {
@@ -296,25 +311,11 @@ void Game::_updateLeaderboard() {
 
 void Game::_printFinalLeaderboard() {
   _updateLeaderboard();
-  std::cout << GREENBACKGROUND << "The final leaderboard is:" << DEFAULT
-            << "\n";
-  int i = 1;
-  for (auto player : _leaderboard) {
-    std::cout << i++ << ":\n"
-              << player.getName() << (player._isOut ? "(out)" : "")
-              << " Money: " << player.getMoney()
-              << ((player.getTotalProfit() > 0) ? GREENBACKGROUND
-                                                : REDBACKGROUND)
-              << "("
-              << (player.getTotalProfit() > 0
-                      ? "+" + std::to_string(player.getTotalProfit())
-                      : std::to_string(player.getTotalProfit()))
-              << ")" << DEFAULT << "\n";
-  }
+  _renderer->finalLeaderboard(_leaderboard);
 }
 
-void Game::_printAction(std::string action, bool isAI) {
-  isAI ? std::cout << " has chosen to " << action << "\n" : std::cout << "";
+void Game::_printAction(PlayerAction action, bool isAI, int amount) {
+  if (isAI) _renderer->action(action, amount);
 }
 
 void Game::_initCardPool() {
@@ -324,142 +325,33 @@ void Game::_initCardPool() {
   else
     return;
   // add the cards to the pool
-  for (int deck = 0; deck < 4; deck++) {
+  for (int deck = 0; deck < _table.decks; deck++) {
     for (int i = 0; i < 4; i++) {
       for (int j = 1; j <= 13; j++) {
-        Poker poker;
-        Suit suit;
-        switch (i) {
-          case 0:
-            suit = spade;
-            if (j == 1) {
-              poker.setNumber("A");
-              poker.setSuit(suit);
-              _cardPool.push_back(poker);
-              break;
-            }
-            if (j == 11) {
-              poker.setNumber("J");
-              poker.setSuit(suit);
-              _cardPool.push_back(poker);
-              break;
-            }
-            if (j == 12) {
-              poker.setNumber("Q");
-              poker.setSuit(suit);
-              _cardPool.push_back(poker);
-              break;
-            }
-            if (j == 13) {
-              poker.setNumber("K");
-              poker.setSuit(suit);
-              _cardPool.push_back(poker);
-              break;
-            }
-
-            poker.setNumber(std::to_string(j));
-            poker.setSuit(suit);
-            _cardPool.push_back(poker);
-            break;
-
-          case 1:
-            suit = heart;
-            if (j == 1) {
-              poker.setNumber("A");
-              poker.setSuit(suit);
-              _cardPool.push_back(poker);
-              break;
-            }
-            if (j == 11) {
-              poker.setNumber("J");
-              poker.setSuit(suit);
-              _cardPool.push_back(poker);
-              break;
-            }
-            if (j == 12) {
-              poker.setNumber("Q");
-              poker.setSuit(suit);
-              _cardPool.push_back(poker);
-              break;
-            }
-            if (j == 13) {
-              poker.setNumber("K");
-              poker.setSuit(suit);
-              _cardPool.push_back(poker);
-              break;
-            }
-
-            poker.setNumber(std::to_string(j));
-            poker.setSuit(suit);
-            _cardPool.push_back(poker);
-            break;
-
-          case 2:
-            suit = diamond;
-            if (j == 1) {
-              poker.setNumber("A");
-              poker.setSuit(suit);
-              _cardPool.push_back(poker);
-              break;
-            }
-            if (j == 11) {
-              poker.setNumber("J");
-              poker.setSuit(suit);
-              _cardPool.push_back(poker);
-              break;
-            }
-            if (j == 12) {
-              poker.setNumber("Q");
-              poker.setSuit(suit);
-              _cardPool.push_back(poker);
-              break;
-            }
-            if (j == 13) {
-              poker.setNumber("K");
-              poker.setSuit(suit);
-              _cardPool.push_back(poker);
-              break;
-            }
-
-            poker.setNumber(std::to_string(j));
-            poker.setSuit(suit);
-            _cardPool.push_back(poker);
-            break;
-          case 3:
-            suit = club;
-            if (j == 1) {
-              poker.setNumber("A");
-              poker.setSuit(suit);
-              _cardPool.push_back(poker);
-              break;
-            }
-            if (j == 11) {
-              poker.setNumber("J");
-              poker.setSuit(suit);
-              _cardPool.push_back(poker);
-              break;
-            }
-            if (j == 12) {
-              poker.setNumber("Q");
-              poker.setSuit(suit);
-              _cardPool.push_back(poker);
-              break;
-            }
-            if (j == 13) {
-              poker.setNumber("K");
-              poker.setSuit(suit);
-              _cardPool.push_back(poker);
-              break;
-            }
-
-            poker.setNumber(std::to_string(j));
-            poker.setSuit(suit);
-            _cardPool.push_back(poker);
-            break;
-        }
+        _cardPool.push_back(Poker(static_cast<Suit>(i), j));
       }
     }
   }
+  _unseen = Shoe::of(_cardPool);
+}
+
+void Game::_dealOpeningCards() {
+  Dealer::deal(_players, _cardPool, _rng);
+  Dealer::deal(_players, _cardPool, _rng);
+  _banker->getPokers()[1].flipTheCard();
+
+  // 翻開的牌大家都看得到，莊家的底牌要等翻開時才移除
+  for (auto &player : _players) {
+    for (auto poker : player.getPokers()) {
+      if (poker.isFaceUp()) _unseen.remove(poker);
+    }
+  }
+}
+
+DecisionContext Game::_contextFor(Player &player) const {
+  return DecisionContext{player.getPokers(),
+                         CardSpan(&_banker->getPokers().front(), 1), _unseen,
+                         player.getMoney(), _table};
 }
 
 void Game::_askForStake() {
@@ -467,12 +359,14 @@ void Game::_askForStake() {
     if (player._isBanker) continue;
     if (player._isOut) continue;
 
-    std::cout << player.getName() << " : ";
+    _renderer->turn(player);
 
-    int stake = player.operation->stake(
-        player.getMoney(), _banker->getPokers(), _cardPool);
+    // 下注時莊家的牌還沒發，不能讓底牌漏給玩家
+    DecisionContext context{player.getPokers(), CardSpan(), _unseen,
+                            player.getMoney(), _table};
+    int stake = player.operation->stake(context);
 
-    _printAction("stake " + std::to_string(stake), player._isAI);
+    _printAction(PlayerAction::STAKE, player._isAI, stake);
 
     player.callBet(stake);
   }
@@ -533,42 +427,25 @@ void Game::_init() {
   }
 }
 
-void Game::_showAllCard() {
-  std::cout << _banker->getName() << "(banker) "
-            << "points : " << _banker->getPoint() << "\n";
-
-  Poker::printPokers(_banker->getPokers());
-
-  for (auto &player : _players) {
-    if (player._isBanker) continue;
-    if (player._isOut) continue;
-    std::cout << player.getName() << " points : " << player.getPoint() << "\n";
-    Poker::printPokers(player.getPokers());
-  }
-}
+void Game::_showAllCard() { _renderer->table(*_banker, _players); }
 
 void Game::_askInsuranceForAllPlayers() {
-  if (_banker->getPokers()[0].getNumber() != "A") return;
+  if (_banker->getPokers()[0].getRank() != Poker::ACE) return;
   for (auto &player : _players) {
     if (player._isBanker) continue;
     if (player._surrendered) continue;
     if (player._isOut) continue;
 
-    std::cout << player.getName() << " : ";
+    _renderer->turn(player);
 
-    if (_banker->getPokers()[0].getNumber() == "A") {
-      std::vector<Poker> dealerVisibleCards = {_banker->getPokers().front()};
-      std::vector<Poker> knownCardPool = _cardPool;
-      knownCardPool.push_back(_banker->getPokers()[1]);
-
-      bool takeInsurance = player.operation->insurance(
-          player.getPokers(), dealerVisibleCards, knownCardPool);
+    if (_banker->getPokers()[0].getRank() == Poker::ACE) {
+      bool takeInsurance = player.operation->insurance(_contextFor(player));
       if (takeInsurance) {
         player._hasInsurance = true;
 
-        _printAction("take the insurance", player._isAI);
+        _printAction(PlayerAction::INSURANCE, player._isAI);
       } else {
-        _printAction("not take the insurance", player._isAI);
+        _printAction(PlayerAction::NO_INSURANCE, player._isAI);
       }
     }
   }
@@ -579,26 +456,22 @@ void Game::_askForDoubleOrSurrender() {
     if (player._isBanker) continue;
     if (player._isOut) continue;
 
-    std::cout << player.getName() << " : ";
-
-    std::vector<Poker> dealerVisibleCards = {_banker->getPokers().front()};
-    std::vector<Poker> knownCardPool = _cardPool;
-    knownCardPool.push_back(_banker->getPokers()[1]);
+    _renderer->turn(player);
 
-    std::map<std::string, bool> result =
-        player.operation->doubleOrSurrender(
-            player.getPokers(), dealerVisibleCards, knownCardPool);
+    switch (player.operation->doubleOrSurrender(_contextFor(player))) {
+      case OpeningDecision::DOUBLE:
+        _printAction(PlayerAction::DOUBLE_DOWN, player._isAI);
 
-    if (result["double"]) {
-      _printAction("double down", player._isAI);
-
-      player._doubled = true;
-    } else if (result["surrender"]) {
-      player._surrendered = true;
+        player._doubled = true;
+        break;
+      case OpeningDecision::SURRENDER:
+        player._surrendered = true;
 
-      _printAction("surrender", player._isAI);
-    } else {
-      _printAction("do nothing", player._isAI);
+        _printAction(PlayerAction::SURRENDER, player._isAI);
+        break;
+      case OpeningDecision::NOTHING:
+        _printAction(PlayerAction::NOTHING, player._isAI);
+        break;
     }
   }
 }
@@ -614,52 +487,44 @@ void Game::_drawForAllPlayers() {
       if (player._doubled) {
         player.doubleDown();
 
-        Dealer::deal(player, _cardPool, false);
-
-        std::cout << player.getName() << " :  has got these cards now:\n\n";
+        Dealer::deal(player, _cardPool, false, _rng);
+        _unseen.remove(player.getPokers().back());
 
-        std::cout << "Point : " << player.getPoint() << "\n";
-        Poker::printPokers(player.getPokers());
+        _renderer->hand(player, false);
 
         if (player.getPoint() == 21) {
-          std::cout << player.getName() << " :  has reached 21 points\n";
+          _renderer->reached21(player);
           break;
         }
 
         if (player.getPoint() > 21) {
-          std::cout << player.getName() << " :  has busted.\n";
+          _renderer->busted(player, false);
           break;
         }
 
         break;
       }
 
-      std::cout << player.getName() << " : ";
-      std::vector<Poker> dealerVisibleCards = {_banker->getPokers().front()};
-      std::vector<Poker> knownCardPool = _cardPool;
-      knownCardPool.push_back(_banker->getPokers()[1]);
-
-      bool toHit = player.operation->hit(
-          player.getPokers(), dealerVisibleCards, knownCardPool);
+      _renderer->turn(player);
+      bool toHit = player.operation->hit(_contextFor(player));
 
       if (toHit) {
-        Dealer::deal(player, _cardPool, false);
+        Dealer::deal(player, _cardPool, false, _rng);
+        _unseen.remove(player.getPokers().back());
 
-        std::cout << " has got these cards now:\n\n";
-        std::cout << "Point : " << player.getPoint() << "\n";
-        Poker::printPokers(player.getPokers());
+        _renderer->hit(player);
 
         if (player.getPoint() == 21) {
-          std::cout << player.getName() << " :  has reached 21 points\n";
+          _renderer->reached21(player);
           break;
         }
 
         if (player.getPoint() > 21) {
-          std::cout << player.getName() << " :  has busted.\n";
+          _renderer->busted(player, false);
           break;
         }
       } else {
-        _printAction("not hit", player._isAI);
+        _printAction(PlayerAction::STAND, player._isAI);
         break;
       }
     }
@@ -669,29 +534,23 @@ void Game::_drawForAllPlayers() {
 void Game::_drawForBanker() {
   // 翻開莊家的第二張牌
   _banker->getPokers()[1].flipTheCard();
+  _unseen.remove(_banker->getPokers()[1]);
 
   // 顯示莊家當前牌
-  std::cout << _banker->getName() << "(banker)"
-            << " : has got these cards now:\n\n";
-  std::cout << "Point : " << _banker->getPoint() << "\n";
-  Poker::printPokers(_banker->getPokers());
+  _renderer->hand(*_banker, true);
 
   // 莊家按H17規則抽牌：小於17點必須抽牌，軟17點也必須抽牌
-  while ((_banker->getPoint() < 17) ||
-         (_banker->getPoint() == 17 && _isSoft17(_banker->getPokers()))) {
+  while (_banker->getHand().dealerShouldHit()) {
     // 抽一張牌
-    Dealer::deal(*_banker, _cardPool, false);
+    Dealer::deal(*_banker, _cardPool, false, _rng);
+    _unseen.remove(_banker->getPokers().back());
 
     // 顯示莊家當前牌
-    std::cout << _banker->getName() << "(banker)"
-              << " : has got these cards now:\n\n";
-    std::cout << "Point : " << _banker->getPoint() << "\n";
-    Poker::printPokers(_banker->getPokers());
+    _renderer->hand(*_banker, true);
 
     // 如果超過21點，顯示爆牌並結束
     if (_banker->getPoint() > 21) {
-      std::cout << _banker->getName() << "(banker)"
-                << " : has busted.\n";
+      _renderer->busted(*_banker, true);
       return;
     }
   }
@@ -706,41 +565,18 @@ void Game::_drawForBanker() {
   // }
 
   // 莊家已達到17點或以上（且不是軟17），停止抽牌
-  std::cout << _banker->getName() << "(banker)"
-            << " : stands with " << _banker->getPoint() << " points.\n";
-}
-
-// 判斷是否為軟17點 (有A且A算作11時總點數為17)
-bool Game::_isSoft17(std::vector<Poker> &cards) {
-  bool hasAce = false;
-  int sum = 0;
-
-  // 先計算所有牌的點數，Ace算作1點
-  for (auto &card : cards) {
-    if (card.getNumber() == "A") {
-      hasAce = true;
-      sum += 1;
-    } else if (card.getNumber() == "J" || card.getNumber() == "Q" ||
-               card.getNumber() == "K") {
-      sum += 10;
-    } else {
-      sum += std::stoi(card.getNumber());
-    }
-  }
-
-  // 如果有Ace且將其中一張Ace算作11點後總點數為17，則為軟17
-  return hasAce && (sum + 10 == 17);
+  _renderer->bankerStands(*_banker);
 }
 
 void Game::_settle() {
   for (auto &player : _players) {
-    int point = player.getPoint();
+    HandState hand = player.getHand();
 
     if (player._isBanker) continue;
     if (player._isOut) continue;
 
     if (player._hasInsurance) {
-      if (_banker->getPokers().size() == 2 && _banker->getPoint() == 21) {
+      if (_banker->getHand().isBlackjack()) {
         _banker->reduceMoney(player.getBet());
         _banker->_gainedFromLastRound -= player.getBet();
         player.getInsurance();
@@ -758,32 +594,18 @@ void Game::_settle() {
     }
 
     // check if the player has five card charlie
-    if (point <= 21 && player.getPokers().size() == 5) {
+    if (hand.isFiveCardCharlie()) {
       _banker->reduceMoney(player.getBet() * 2);
       _banker->_gainedFromLastRound -= player.getBet() * 2;
       player.winBet("five card charlie");
       continue;
     }
     // check if the player has shun
-    if (point == 21 && player.getPokers().size() == 3) {
-      std::map<int, bool> numberMap;
-      for (auto poker : player.getPokers()) {
-        if (poker.getNumber() == "6") {
-          numberMap[6] = true;
-        }
-        if (poker.getNumber() == "7") {
-          numberMap[7] = true;
-        }
-        if (poker.getNumber() == "8") {
-          numberMap[8] = true;
-        }
-      }
-      if (numberMap[6] && numberMap[7] && numberMap[8]) {
-        _banker->reduceMoney(player.getBet() * 2);
-        _banker->_gainedFromLastRound -= player.getBet() * 2;
-        player.winBet("shun");
-        continue;
-      }
+    if (hand.isShun()) {
+      _banker->reduceMoney(player.getBet() * 2);
+      _banker->_gainedFromLastRound -= player.getBet() * 2;
+      player.winBet("shun");
+      continue;
     }
 
     // not the special case
@@ -810,10 +632,8 @@ void Game::_settle() {
       }
 
       // 判斷玩家是否有黑傑克 (Ace + 10值牌)
-      bool playerHasBlackjack =
-          (player.getPokers().size() == 2 && player.getPoint() == 21);
-      bool bankerHasBlackjack =
-          (_banker->getPokers().size() == 2 && _banker->getPoint() == 21);
+      bool playerHasBlackjack = hand.isBlackjack();
+      bool bankerHasBlackjack = _banker->getHand().isBlackjack();
 
       // 比較點數
       if (playerHasBlackjack && !bankerHasBlackjack) {
@@ -838,18 +658,16 @@ void Game::_settle() {
     }
   }
 }
-int Game::getLeasetBet() { return _leastBet; }
 
 void Game::_kickOut() {
   for (int i = 0; i < _players.size(); i++) {
     // check if the player is out of the game or not
     if (_players[i]._isOut) continue;
-    if (_players[i].getMoney() < _leastBet) {
-      std::cout << _players[i].getName()
-                << " has been kicked out!(can't afford the least bet)\n";
+    if (_players[i].getMoney() < _table.leastBet) {
+      _renderer->kickedOut(_players[i], false);
       _players[i].out();
     } else if (_players[i].getMoney() == 0) {
-      std::cout << _players[i].getName() << " has been kicked out!(no money)\n";
+      _renderer->kickedOut(_players[i], true);
       _players[i].out();
     }
   }
@@ -1,14 +1,34 @@
+#include <exception>
 #include <iostream>
+#include <string>
 
 #include "game.h"
 #define DEFAULT "\033[0;1m"
 
-int main() {
-  Game game = Game::getInstance();
+int main(int argc, char *argv[]) {
+  GameConfig config;
 
-  std::cout << DEFAULT << "Welcome to BlackJack\n";
+  // --strategy-table <檔案>：AI 改查 generate_strategy_table 產生的策略表
+  for (int i = 1; i < argc; i++) {
+    std::string arg = argv[i];
+    if (arg == "--strategy-table" && i + 1 < argc) {
+      config.strategyTable = argv[++i];
+    } else {
+      std::cerr << "usage: " << argv[0] << " [--strategy-table <file>]\n";
+      return 1;
+    }
+  }
 
-  bool isTestMode = true;
+  try {
+    Game game(config);
 
-  game.start(isTestMode);
-}
\ No newline at end of file
+    std::cout << DEFAULT << "Welcome to BlackJack\n";
+
+    bool isTestMode = true;
+
+    game.start(isTestMode);
+  } catch (const std::exception &error) {
+    std::cerr << error.what() << std::endl;
+    return 1;
+  }
+}
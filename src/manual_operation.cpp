@@ -2,11 +2,7 @@
 
 #include <iostream>
 
-#include "game.h"
-
-bool ManualOperation::insurance(std::vector<Poker> playerCards,
-                                std::vector<Poker> dealerVisibleCards,
-                                std::vector<Poker> cardPool) {
+bool ManualOperation::insurance(const DecisionContext&) {
   std::string input;
   std::cout
       << "Beacause the banker has shown an A. Do you want to take "
@@ -30,9 +26,7 @@ bool ManualOperation::insurance(std::vector<Poker> playerCards,
   }
 }
 
-bool ManualOperation::hit(std::vector<Poker> playerCards,
-                          std::vector<Poker> dealerVisibleCards,
-                          std::vector<Poker> cardPool) {
+bool ManualOperation::hit(const DecisionContext&) {
   std::string input;
   std::cout << "Do you want to hit a card?\n"
             << "1 yes\n"
@@ -53,15 +47,9 @@ bool ManualOperation::hit(std::vector<Poker> playerCards,
   }
 }
 
-std::map<std::string, bool> ManualOperation::doubleOrSurrender(
-    std::vector<Poker> playerCards, std::vector<Poker> dealerVisibleCards,
-    std::vector<Poker> cardPool) {
+OpeningDecision ManualOperation::doubleOrSurrender(const DecisionContext&) {
   std::string input;
-  std::map<std::string, bool> result;
-  int point = Poker::getPokerValue(playerCards);
-  result["double"] = false;
-  result["surrender"] = false;
-  result["nothing"] = false;
+  OpeningDecision result = OpeningDecision::NOTHING;
   std::cout << "Which action do you want to take?\n"
             << "1  double down(Beacause your point is 11. "
             << "It can only take one more card)\n"
@@ -78,13 +66,13 @@ std::map<std::string, bool> ManualOperation::doubleOrSurrender(
     } else {
       if (input == "1") {
         std::cout << "You have chosen to double down\n";
-        result["double"] = true;
+        result = OpeningDecision::DOUBLE;
       } else if (input == "2") {
         std::cout << "You have chosen to surrender\n";
-        result["surrender"] = true;
+        result = OpeningDecision::SURRENDER;
       } else {
         std::cout << "You have chosen to do nothing\n";
-        result["nothing"] = true;
+        result = OpeningDecision::NOTHING;
       }
     }
 
@@ -93,12 +81,12 @@ std::map<std::string, bool> ManualOperation::doubleOrSurrender(
   }
 }
 
-int ManualOperation::stake(int money, std::vector<Poker> dealerVisibleCards,
-                           std::vector<Poker> cardPool) {
+int ManualOperation::stake(const DecisionContext& context) {
+  const int money = context.money;
+  const TableContext& table = context.table;
   std::string input;
-  Game game = Game::getInstance();
   std::cout << "How much money do you want to stake(atleast: "
-            << game.getLeasetBet() << "): \n";
+            << table.leastBet << "): \n";
   while (true) {
     std::cin >> input;
     bool isValid = true;
@@ -122,9 +110,9 @@ int ManualOperation::stake(int money, std::vector<Poker> dealerVisibleCards,
       continue;
     }
 
-    if (number < game.getLeasetBet()) {
+    if (number < table.leastBet) {
       std::cout << "Please enter a number that is greater than or equal to "
-                << game.getLeasetBet() << "\n";
+                << table.leastBet << "\n";
       continue;
     }
 
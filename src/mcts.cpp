@@ -1,357 +1,1083 @@
 #include "mcts.h"
 
+#include <cassert>
+#include <chrono>
+#include <cmath>
+#include <functional>
+#include <random>
+#include <thread>
+
+#include "dealer_odds.h"
+#include "hand_state.h"
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+// 回傳從 last 到現在的奈秒數，並把 last 設成現在
+std::uint64_t lap(Clock::time_point& last) {
+  Clock::time_point now = Clock::now();
+  auto elapsed =
+      std::chrono::duration_cast<std::chrono::nanoseconds>(now - last);
+  last = now;
+  return static_cast<std::uint64_t>(elapsed.count());
+}
+
+// 依玩家的牌和莊家的最終結果算出這一局的價值
+double score(bool doubled, bool insured, const HandState& playerHand,
+             bool dealerBlackjack, bool dealerBust, int dealerTotal) {
+  double result = 0;
+
+  // 莊家有黑傑克
+  if (dealerBlackjack) {
+    // 玩家有無保險
+    if (insured) {
+      result = INSURANCE_SUCCESS_VALUE;
+    } else {
+      result = doubled ? DOUBLE_LOSE_VALUE : NORMAL_LOSE_VALUE;
+    }
+  } else {
+    if (playerHand.isFiveCardCharlie() || playerHand.isShun()) {
+      // 五張牌查理 (Five Card Charlie) 或順子 (6-7-8)
+      result = doubled ? DOUBLE_WIN_VALUE : SPECIAL_WIN_VALUE;
+    } else if (playerHand.isBust()) {  // 玩家爆牌
+      result = doubled ? DOUBLE_LOSE_VALUE : NORMAL_LOSE_VALUE;
+    } else if (dealerBust) {  // 莊家爆牌
+      result = doubled ? DOUBLE_WIN_VALUE : NORMAL_WIN_VALUE;
+    } else if (playerHand.isBlackjack()) {  // 玩家黑傑克
+      result = doubled ? DOUBLE_WIN_VALUE : SPECIAL_WIN_VALUE;
+    } else if (playerHand.total() > dealerTotal) {  // 玩家點數高
+      result = doubled ? DOUBLE_WIN_VALUE : NORMAL_WIN_VALUE;
+    } else if (playerHand.total() < dealerTotal) {  // 莊家點數高
+      result = doubled ? DOUBLE_LOSE_VALUE : NORMAL_LOSE_VALUE;
+    } else {  // 平局
+      result = DRAW_VALUE;
+    }
+
+    if (insured) {
+      result -= INSURANCE_FAIL_VALUE;
+    }
+  }
+
+  return result < 0 ? 0 : result;
+}
+
+// 把 total 次模擬依 shoe 的組成分給每種牌值：還有的牌值至少一次，
+// 剩下的依機率分配，小數部分大的先多拿一次。total 不夠每種一次時回傳 false
+bool allocateStrata(const Shoe& shoe, int total,
+                    std::array<int, Shoe::POINTS>& strata) {
+  strata.fill(0);
+  int present = 0;
+  for (int point = 1; point <= Shoe::POINTS; point++) {
+    if (shoe.count(point) > 0) present++;
+  }
+  if (present == 0 || total < present) return false;
+
+  const int spare = total - present;
+  std::array<double, Shoe::POINTS> remainders{};
+  int assigned = 0;
+  for (int point = 1; point <= Shoe::POINTS; point++) {
+    if (shoe.count(point) == 0) continue;
+    double share = static_cast<double>(spare) * shoe.count(point) / shoe.size();
+    int whole = static_cast<int>(share);
+    strata[point - 1] = 1 + whole;
+    remainders[point - 1] = share - whole;
+    assigned += 1 + whole;
+  }
+
+  for (; assigned < total; assigned++) {
+    int largest = 0;
+    for (int i = 1; i < Shoe::POINTS; i++) {
+      if (remainders[i] > remainders[largest]) largest = i;
+    }
+    strata[largest]++;
+    remainders[largest] = -1;
+  }
+  return true;
+}
+
+// 模擬裡依序抽牌用的亂數。開啟對偶抽樣時每兩次模擬配成一對，
+// 第二次的第 j 張牌用第一次第 j 張牌的 1 - u 抽，超過第一次的張數再用新的亂數
+class DrawSequence {
+ public:
+  DrawSequence(Xoshiro256& rng, bool antithetic)
+      : _rng(rng), _antithetic(antithetic), _mirror(true), _count(0),
+        _index(0) {}
+
+  // 開始下一次模擬
+  void next() {
+    _mirror = _antithetic && !_mirror;
+    _index = 0;
+    if (!_mirror) _count = 0;
+  }
+
+  // 下一次模擬重新配對，不跟前一次配成一對
+  void restart() { _mirror = true; }
+
+  int draw(Shoe& shoe) {
+    if (!_antithetic) return shoe.draw(_rng);
+
+    double u;
+    if (_mirror && _index < _count) {
+      u = 1.0 - _uniforms[_index];
+    } else {
+      u = std::uniform_real_distribution<double>(0.0, 1.0)(_rng);
+      if (!_mirror && _count < _uniforms.size()) _uniforms[_count++] = u;
+    }
+    _index++;
+
+    int target = std::min(static_cast<int>(u * shoe.size()), shoe.size() - 1);
+    return shoe.drawAt(target);
+  }
+
+ private:
+  Xoshiro256& _rng;
+  bool _antithetic;
+  // 這次模擬是一對裡的第二次
+  bool _mirror;
+  std::array<double, 32> _uniforms;
+  std::size_t _count;
+  std::size_t _index;
+};
+
+}  // namespace
+
 mcts::MCTS::MCTS(int simualtions, std::vector<Poker> pokers,
                  std::vector<Poker> knownCardPool,
-                 std::vector<Poker> dealerVisibleCards)
+                 std::vector<Poker> dealerVisibleCards, Config config)
+    : MCTS(simualtions, HandState::of(pokers), Shoe::of(knownCardPool),
+           dealerVisibleCards, config) {}
+
+mcts::MCTS::MCTS(int simualtions, const HandState& hand, const Shoe& unseen,
+                 CardSpan dealerVisibleCards, Config config)
     : _simulations(simualtions),
-      dealerVisibleCards(dealerVisibleCards),
-      _rng(std::random_device{}()) {
-  unsigned int numThreads = std::thread::hardware_concurrency();
-  numThreads = numThreads > 0 ? numThreads : 4;
-  _threadPool = std::make_unique<ThreadPool>(numThreads);
+      dealerVisibleCards(dealerVisibleCards.toVector()),
+      _config(config),
+      _nextStream(0),
+      _nodeCount(0),
+      _rootHand(hand),
+      _rootShoe(unseen) {
+  _reserveNodes(1 + MAX_CHILDREN);
+  root = _newNode(NO_NODE, Action::HIT);
+}
 
-  root = std::make_shared<Node>();
+mcts::MCTS::MCTS(const MCTS& search, std::uint64_t seed)
+    : _simulations(search._simulations),
+      dealerVisibleCards(search.dealerVisibleCards),
+      _config(search._config),
+      _nextStream(0),
+      _nodeCount(0),
+      _rootHand(search._rootHand),
+      _rootShoe(search._rootShoe) {
+  _config.parallel = ParallelMode::TREE;
+  _config.threads = 1;
+  _config.seed = seed;
 
-  root->cardPool = knownCardPool;
-  root->pokers = pokers;
-  root->value = 0;
-  root->visits = 0;
-  root->action = Action::HIT;
-  root->parent = nullptr;
+  // 新的根節點沿用原本根節點的抽牌數和保險狀態，合法動作才會一樣
+  const Node& searchRoot = search._nodes[search.root];
+  _reserveNodes(1 + MAX_CHILDREN);
+  root = _newNode(NO_NODE, searchRoot.action);
+  _nodes[root].drawCount = searchRoot.drawCount;
+  _nodes[root].insured = searchRoot.insured;
+}
 
-  _playoutTimes = 2000;
+mcts::Node::Node()
+    : parent(NO_NODE),
+      value(0),
+      squares(0),
+      visits(0),
+      virtualLoss(0),
+      expandState(UNEXPANDED),
+      drawCount(0),
+      chance(false),
+      point(0),
+      insured(false),
+      action(Action::HIT) {
+  children.fill(NO_NODE);
 }
 
-std::shared_ptr<mcts::Node> mcts::MCTS::run() {
-  std::shared_ptr<Node> bestChild;
+mcts::Node::Node(const Node& node) : Node() { *this = node; }
 
-  // 初始化子節點
-  for (int i = 0; i < MAX_CHILDREN; ++i) {
-    if (dealerVisibleCards[0].getNumber() != "A" &&
-        static_cast<Action>(i) == Action::INSURANCE) {
-      continue;
+mcts::Node& mcts::Node::operator=(const Node& node) {
+  parent = node.parent;
+  children = node.children;
+  value.store(node.value.load());
+  squares.store(node.squares.load());
+  visits.store(node.visits.load());
+  virtualLoss.store(node.virtualLoss.load());
+  expandState.store(node.expandState.load());
+  drawCount = node.drawCount;
+  chance = node.chance;
+  point = node.point;
+  insured = node.insured;
+  action = node.action;
+  return *this;
+}
+
+namespace {
+
+// C++17 的 atomic<float> 沒有 fetch_add，用 CAS 迴圈
+void atomicAdd(std::atomic<float>& target, double amount) {
+  float current = target.load(std::memory_order_relaxed);
+  while (!target.compare_exchange_weak(current,
+                                       current + static_cast<float>(amount),
+                                       std::memory_order_relaxed)) {
+  }
+}
+
+}  // namespace
+
+void mcts::Node::addResult(double result, double sample) {
+  atomicAdd(value, result);
+  atomicAdd(squares, sample * sample);
+  visits.fetch_add(1, std::memory_order_relaxed);
+}
+
+void mcts::Node::setMean(double mean, double sample) {
+  std::uint32_t count = visits.fetch_add(1, std::memory_order_relaxed) + 1;
+  value.store(static_cast<float>(mean * count), std::memory_order_relaxed);
+  atomicAdd(squares, sample * sample);
+}
+
+void mcts::MCTS::_reserveNodes(std::size_t count) {
+  std::size_t needed = _nodeCount.load() + count;
+  if (_nodes.size() < needed) _nodes.resize(needed);
+}
+
+mcts::NodeId mcts::MCTS::_newNode(NodeId parent, Action action,
+                                  std::uint8_t point) {
+  NodeId id = _nodeCount.fetch_add(1, std::memory_order_relaxed);
+  // 搜尋中不能重新配置 arena，空間要由 _reserveNodes 先留好
+  assert(id < _nodes.size());
+  Node& node = _nodes[id];
+  node.parent = parent;
+  node.action = action;
+  node.drawCount = 0;
+  node.point = point;
+  node.chance = action == Action::HIT && point == 0 && parent != NO_NODE;
+  node.insured = action == Action::INSURANCE;
+
+  if (parent != NO_NODE) {
+    node.drawCount = _nodes[parent].drawCount;
+    node.insured = node.insured || _nodes[parent].insured;
+  }
+  // 看到牌才算拿到，機會節點本身還沒有
+  if (point != 0) node.drawCount++;
+
+  return id;
+}
+
+void mcts::MCTS::_stateAt(NodeId node, HandState& hand, Shoe& shoe) const {
+  // 往上走收集抽到的牌，再照順序加回手牌，順子和五張牌要看順序
+  std::array<std::uint8_t, 32> points;
+  std::size_t count = 0;
+  for (; node != root && node != NO_NODE; node = _nodes[node].parent) {
+    if (_nodes[node].point != 0 && count < points.size()) {
+      points[count++] = _nodes[node].point;
     }
+  }
+
+  hand = _rootHand;
+  shoe = _rootShoe;
+  while (count > 0) {
+    std::uint8_t point = points[--count];
+    hand.addPoint(point);
+    if (shoe.count(point) > 0) shoe.remove(point);
+  }
+}
+
+int mcts::MCTS::_threadCount() const {
+  if (_config.threads > 0) return _config.threads;
+  return static_cast<int>(_pool().size());
+}
+
+ThreadPool& mcts::MCTS::_pool() const {
+  return _config.pool != nullptr ? *_config.pool : ThreadPool::shared();
+}
+
+const mcts::RolloutPolicy& mcts::MCTS::_rollout() const {
+  return _config.rollout != nullptr ? *_config.rollout
+                                    : BasicStrategyPolicy::shared();
+}
+
+const mcts::Node& mcts::MCTS::run() { return run(_simulations); }
+
+const mcts::Node& mcts::MCTS::run(int iterations) {
+  SearchLimits limits;
+  limits.iterations = std::max(iterations, 0);
+  search(limits);
+  return _nodes[_bestChild()];
+}
 
-    std::shared_ptr<Node> child = std::make_shared<Node>();
-    child->parent = root;
-    child->action = static_cast<Action>(i);
-    child->pokers = root->pokers;
-    child->drawCount = 1;
-    child->cardPool = root->cardPool;
-    root->children[i] = child;
+mcts::SearchResult mcts::MCTS::search(const SearchLimits& requested) {
+  SearchLimits limits = requested;
+  if (limits.unlimited()) limits.iterations = _simulations;
+
+  TimePoint deadline = TimePoint::max();
+  if (limits.timeLimit.count() > 0) {
+    deadline = Clock::now() +
+               std::chrono::duration_cast<Clock::duration>(limits.timeLimit);
   }
 
-  for (int i = 0; i < _simulations; ++i) {
-    auto node = selection(root);
+  _search(limits, deadline);
+
+  SearchResult result;
+  NodeId best = _bestChild();
+  result.best = best == NO_NODE ? Action::STAND : _nodes[best].action;
+  result.actions = actionTable();
+  result.stats = _stats;
+  return result;
+}
+
+void mcts::MCTS::_search(const SearchLimits& limits, TimePoint deadline) {
+  _stats = SearchStats();
+  Clock::time_point start = Clock::now();
+  NodeId nodesBefore = _nodeCount.load();
+
+  // 初始化子節點
+  _reserveNodes(1 + MAX_CHILDREN);
+  expansion(root);
+
+  if (_config.parallel == ParallelMode::ROOT && _threadCount() > 1) {
+    _runRoot(limits, deadline);
+  } else {
+    // 只限制迭代次數時一次跑完；有時間或其他預算時分批跑，
+    // 每批之間檢查預算並補足 arena 的空間
+    const bool batched = limits.timeLimit.count() > 0 ||
+                         limits.playouts > 0 || limits.nodes > 0 ||
+                         limits.confidence > 0;
+    const std::int64_t batchSize =
+        batched ? 64 * static_cast<std::int64_t>(_threadCount())
+                : std::numeric_limits<int>::max();
+
+    const bool workBounded =
+        limits.iterations < 0 && limits.timeLimit.count() <= 0;
+    std::uint64_t idleIterations = 0;
 
-    if (node->visits != 0) {
-      expansion(node);
+    // 迴圈條件不成立就是時間到了
+    _stats.stopReason = StopReason::TIME;
+    while (Clock::now() < deadline) {
+      // 這一批最多跑幾次，記下是哪個預算限制的
+      std::int64_t batch = batchSize;
+      StopReason limiting = StopReason::ITERATIONS;
+      auto cap = [&batch, &limiting](std::int64_t allowed, StopReason reason) {
+        if (allowed < batch) {
+          batch = allowed;
+          limiting = reason;
+        }
+      };
+
+      if (limits.iterations >= 0) {
+        cap(limits.iterations - static_cast<std::int64_t>(_stats.iterations),
+            StopReason::ITERATIONS);
+      }
+      if (limits.playouts > 0) {
+        std::uint64_t left = _stats.playouts >= limits.playouts
+                                 ? 0
+                                 : limits.playouts - _stats.playouts;
+        cap((left + _config.playoutsPerLeaf - 1) / _config.playoutsPerLeaf,
+            StopReason::PLAYOUTS);
+      }
+      if (limits.nodes > 0) {
+        // 每次迭代最多新建 MAX_OUTCOMES 個節點，不會超過預算
+        std::uint64_t used = _nodeCount.load() - nodesBefore;
+        std::uint64_t left = used >= limits.nodes ? 0 : limits.nodes - used;
+        cap(left / MAX_OUTCOMES, StopReason::NODES);
+      }
+      if (batch <= 0) {
+        _stats.stopReason = limiting;
+        break;
+      }
 
-      auto child = selection(node);
+      _reserveNodes(MAX_OUTCOMES * (static_cast<std::size_t>(batch) + 1));
+      NodeId nodesBeforeBatch = _nodeCount.load();
+      std::uint64_t playoutsBeforeBatch = _stats.playouts;
+      std::uint64_t iterationsBeforeBatch = _stats.iterations;
+      _runBatch(static_cast<int>(batch), deadline);
+
+      if (limits.confidence > 0 && _separated(limits.confidence)) {
+        _stats.stopReason = StopReason::CONFIDENCE;
+        break;
+      }
 
-      if (child == node) {
-        backpropagation(node, node->value);
+      // 只有節點或模擬預算時，樹收斂到終局節點後可能再也用不到預算，
+      // 連續很多次迭代都沒有新節點也沒有模擬就停下來
+      if (_nodeCount.load() == nodesBeforeBatch &&
+          _stats.playouts == playoutsBeforeBatch) {
+        idleIterations += _stats.iterations - iterationsBeforeBatch;
       } else {
-        double result = playout(child);
-        backpropagation(child, result);
+        idleIterations = 0;
       }
-    } else {
-      double result = playout(node);
-      backpropagation(node, result);
+      if (workBounded && idleIterations >= 4096) {
+        _stats.stopReason = StopReason::CONVERGED;
+        break;
+      }
+    }
+  }
+
+  _stats.nodesAllocated += _nodeCount.load() - nodesBefore;
+  _stats.wallNs = lap(start);
+}
+
+void mcts::MCTS::_runBatch(int iterations, TimePoint deadline) {
+  if (_config.parallel == ParallelMode::TREE) {
+    _runTree(iterations, deadline);
+  } else {
+    for (int i = 0; i < iterations && Clock::now() < deadline; ++i) {
+      _iterate(nullptr, _stats);
     }
   }
+}
+
+bool mcts::MCTS::_separated(double confidence) const {
+  if (confidence >= 1) return false;
+
+  NodeId best = _bestChild();
+  if (best == NO_NODE) return false;
+
+  int children = 0;
+  for (NodeId child : _nodes[root].children) {
+    if (child != NO_NODE) children++;
+  }
+  if (children < 2) return true;
+
+  // 經驗 Bernstein 界 (Maurer & Pontil)：價值在 [0, 1] 之間，n 次訪問、
+  // 樣本變異數 V 時，平均值離真實值超過
+  // sqrt(2V ln(2/δ) / n) + 7 ln(2/δ) / 3(n-1) 的機率小於 δ。
+  // 每個葉節點的價值是很多次模擬的平均，變異數很小，比 Hoeffding 界窄很多。
+  // δ 平均分給 k 個子節點，全部同時成立的機率至少是 confidence
+  const double logTerm = std::log(2.0 * children / (1.0 - confidence));
+  auto mean = [this](NodeId child) {
+    return static_cast<double>(_nodes[child].value) / _nodes[child].visits;
+  };
+  auto radius = [this, logTerm, &mean](NodeId child) {
+    double n = _nodes[child].visits;
+    double average = mean(child);
+    double squares = _nodes[child].squares;
+    double variance = std::max(0.0, (squares - n * average * average) / (n - 1));
+    return std::sqrt(2 * variance * logTerm / n) + 7 * logTerm / (3 * (n - 1));
+  };
+
+  if (_nodes[best].visits < 2) return false;
+  double bestLower = mean(best) - radius(best);
+
+  for (NodeId child : _nodes[root].children) {
+    if (child == NO_NODE || child == best) continue;
+    if (_nodes[child].visits < 2) return false;
+    if (mean(child) + radius(child) >= bestLower) return false;
+  }
+  return true;
+}
 
-  int maxVisits = 0;
-  for (const auto& child : root->children) {
-    if (child == nullptr) continue;
-    if (child->visits > maxVisits) {
-      maxVisits = child->visits;
+mcts::NodeId mcts::MCTS::_bestChild() const {
+  NodeId bestChild = NO_NODE;
+  std::uint32_t maxVisits = 0;
+  for (NodeId child : _nodes[root].children) {
+    if (child == NO_NODE) continue;
+    if (bestChild == NO_NODE || _nodes[child].visits > maxVisits) {
+      maxVisits = _nodes[child].visits;
       bestChild = child;
     }
   }
   return bestChild;
 }
 
-std::shared_ptr<mcts::Node> mcts::MCTS::selection(std::shared_ptr<Node> root) {
-  std::shared_ptr<Node> node = root;
-  while (true) {
-    bool hasChildren = false;
+void mcts::MCTS::_iterate(Xoshiro256* rng, SearchStats& stats) {
+  Clock::time_point last = Clock::now();
+
+  auto evaluate = [&](NodeId leaf) {
+    if (rng == nullptr) {
+      // 模擬和等待的時間由 _playout 自己記
+      double result = _playout(leaf, stats);
+      last = Clock::now();
+      return result;
+    }
+    double result = _simulate(leaf, _config.playoutsPerLeaf, *rng) /
+                    _config.playoutsPerLeaf;
+    stats.playouts += _config.playoutsPerLeaf;
+    stats.playoutNs += lap(last);
+    return result;
+  };
+  auto backpropagate = [&](NodeId leaf, double result) {
+    backpropagation(leaf, result);
+    stats.backpropagationNs += lap(last);
+  };
 
-    std::shared_ptr<Node> bestChild = nullptr;
+  stats.iterations++;
+
+  // 根節點也要算 virtual loss，子節點的探索項才會跟著變
+  _nodes[root].virtualLoss.fetch_add(1, std::memory_order_relaxed);
+  NodeId node = selection(root);
+  stats.selectionNs += lap(last);
+
+  if (_nodes[node].visits.load(std::memory_order_relaxed) == 0) {
+    stats.maxDepth = std::max(stats.maxDepth, _depth(node));
+    backpropagate(node, evaluate(node));
+    return;
+  }
+
+  expansion(node);
+  stats.expansionNs += lap(last);
+  NodeId child = selection(node);
+  stats.selectionNs += lap(last);
+  stats.maxDepth = std::max(stats.maxDepth, _depth(child));
+
+  if (child != node) {
+    backpropagate(child, evaluate(child));
+  } else if (_isTerminal(node)) {
+    // 終局節點：用平均值回傳
+    backpropagate(node, _nodes[node].value.load() / _nodes[node].visits);
+  } else {
+    // 其他執行緒正在展開這個節點，先模擬它本身
+    backpropagate(node, evaluate(node));
+  }
+}
+
+std::uint32_t mcts::MCTS::_depth(NodeId node) const {
+  std::uint32_t depth = 0;
+  while (node != root && node != NO_NODE) {
+    node = _nodes[node].parent;
+    depth++;
+  }
+  return depth;
+}
+
+void mcts::MCTS::_runTree(int iterations, TimePoint deadline) {
+  int numThreads = std::min(_threadCount(), std::max(iterations, 1));
+  std::atomic<int> remaining(iterations);
+
+  std::uint64_t streamBase = _nextStream;
+  _nextStream += numThreads;
+
+  auto worker = [this, &remaining, deadline](std::uint64_t stream) {
+    Xoshiro256 rng = Xoshiro256::forStream(_config.seed, stream);
+    SearchStats stats;
+    while (Clock::now() < deadline &&
+           remaining.fetch_sub(1, std::memory_order_relaxed) > 0) {
+      _iterate(&rng, stats);
+    }
+    std::lock_guard<std::mutex> lock(_statsMutex);
+    _stats.merge(stats);
+  };
 
-    double maxUCBValue = std::numeric_limits<double>::lowest();
-    for (const auto& child : node->children) {
-      if (!child) continue;
-      if (bestChild == nullptr || child->getUCBValue() > maxUCBValue) {
-        bestChild = child;
-        maxUCBValue = child->getUCBValue();
-        hasChildren = true;
+  TaskGroup group(_pool());
+  for (int i = 1; i < numThreads; i++) {
+    group.run([&worker, stream = streamBase + i] { worker(stream); });
+  }
+  // 呼叫的執行緒自己也跑一份
+  worker(streamBase);
+
+  group.wait();
+}
+
+void mcts::MCTS::_runRoot(const SearchLimits& limits, TimePoint deadline) {
+  int numThreads = _threadCount();
+  if (limits.iterations >= 0) {
+    numThreads = std::min(numThreads, std::max(limits.iterations, 1));
+  }
+
+  std::uint64_t streamBase = _nextStream;
+  _nextStream += numThreads;
+
+  // 每棵樹的種子都由主種子推出，合併的順序固定，同樣的種子結果相同
+  std::vector<std::unique_ptr<MCTS>> trees;
+  for (int i = 0; i < numThreads; i++) {
+    Xoshiro256 seeder = Xoshiro256::forStream(_config.seed, streamBase + i);
+    trees.emplace_back(new MCTS(*this, seeder()));
+  }
+
+  _pool().parallel_for(0, numThreads, 1, [&](std::size_t i) {
+    // 預算平均分給每棵樹，除不盡的給第一棵
+    SearchLimits share = limits;
+    if (limits.iterations >= 0) {
+      share.iterations = limits.iterations / numThreads +
+                         (i == 0 ? limits.iterations % numThreads : 0);
+    }
+    if (limits.playouts > 0) {
+      share.playouts = (limits.playouts + numThreads - 1) / numThreads;
+    }
+    if (limits.nodes > 0) {
+      share.nodes = (limits.nodes + numThreads - 1) / numThreads;
+    }
+    trees[i]->_search(share, deadline);
+  });
+
+  _stats.stopReason = trees.front()->_stats.stopReason;
+
+  // 只合併第一層，更深的節點不會更新
+  for (auto& tree : trees) {
+    _stats.merge(tree->_stats);
+
+    const Node& treeRoot = tree->_nodes[tree->root];
+    for (int i = 0; i < MAX_CHILDREN; ++i) {
+      NodeId treeChild = treeRoot.children[i];
+      if (treeChild == NO_NODE) continue;
+
+      NodeId child = _nodes[root].children[i];
+      if (child == NO_NODE) {
+        _reserveNodes(1);
+        child = _newNode(root, static_cast<Action>(i));
+        _nodes[root].children[i] = child;
       }
+      _nodes[child].visits += tree->_nodes[treeChild].visits.load();
+      _nodes[child].value.store(_nodes[child].value.load() +
+                                tree->_nodes[treeChild].value.load());
+      _nodes[child].squares.store(_nodes[child].squares.load() +
+                                  tree->_nodes[treeChild].squares.load());
     }
+    _nodes[root].visits += treeRoot.visits.load();
+    _nodes[root].value.store(_nodes[root].value.load() +
+                             treeRoot.value.load());
+    _nodes[root].squares.store(_nodes[root].squares.load() +
+                               treeRoot.squares.load());
+  }
+}
+
+mcts::ActionTable mcts::MCTS::actionTable() const {
+  ActionTable table{};
+  for (int i = 0; i < MAX_CHILDREN; ++i) {
+    NodeId child = _nodes[root].children[i];
+    if (child == NO_NODE) continue;
+    table[i].available = true;
+    table[i].visits = _nodes[child].visits;
+    table[i].value = _nodes[child].visits == 0
+                         ? 0
+                         : _nodes[child].value / _nodes[child].visits;
+  }
+  return table;
+}
+
+mcts::Action mcts::bestAction(const ActionTable& table,
+                              std::initializer_list<Action> allowed) {
+  Action best = Action::STAND;
+  std::uint32_t maxVisits = 0;
+  bool found = false;
+  for (Action action : allowed) {
+    if (!table[action].available) continue;
+    if (!found || table[action].visits > maxVisits) {
+      best = action;
+      maxVisits = table[action].visits;
+      found = true;
+    }
+  }
+  return best;
+}
+
+mcts::Action mcts::MCTS::bestAction(
+    std::initializer_list<Action> allowed) const {
+  return mcts::bestAction(actionTable(), allowed);
+}
+
+void mcts::MCTS::advance(Action action) {
+  NodeId child = _nodes[root].children[action];
+  if (child == NO_NODE) {
+    _reserveNodes(1);
+    child = _newNode(root, action);
+    _nodes[root].children[action] = child;
+  }
+
+  // 子樹升為新的根節點，原本的統計值都保留
+  _nodes[child].parent = NO_NODE;
+  root = child;
+}
 
-    if (!hasChildren) {
+void mcts::MCTS::advance(Poker dealt) {
+  NodeId chance = _nodes[root].children[Action::HIT];
+  if (chance == NO_NODE) {
+    _reserveNodes(1);
+    chance = _newNode(root, Action::HIT);
+    _nodes[root].children[Action::HIT] = chance;
+  }
+
+  std::uint8_t point = RANK_POINT[dealt.getRank()];
+  NodeId outcome = _nodes[chance].children[point - 1];
+  if (outcome == NO_NODE) {
+    _reserveNodes(1);
+    outcome = _newNode(chance, Action::HIT, point);
+    _nodes[chance].children[point - 1] = outcome;
+  }
+
+  // 拿到的這張牌之後的子樹升為新的根節點，原本的統計值都保留
+  _nodes[outcome].parent = NO_NODE;
+  root = outcome;
+  _rootHand.add(dealt);
+  _rootShoe.remove(dealt);
+}
+
+void mcts::MCTS::updateShoe(const std::vector<Poker>& knownCardPool) {
+  _rootShoe = Shoe::of(knownCardPool);
+}
+
+void mcts::MCTS::updateShoe(const Shoe& unseen) { _rootShoe = unseen; }
+
+mcts::NodeId mcts::MCTS::selection(NodeId root) {
+  HandState hand;
+  Shoe shoe;
+  _stateAt(root, hand, shoe);
+
+  NodeId node = root;
+  while (true) {
+    if (_nodes[node].expandState.load(std::memory_order_acquire) !=
+        Node::EXPANDED)
+      return node;
+
+    bool chance = _nodes[node].chance;
+    NodeId bestChild =
+        chance ? _selectOutcome(node, shoe) : _selectAction(node);
+
+    if (bestChild == NO_NODE) {
       return node;
     }
 
+    _nodes[bestChild].virtualLoss.fetch_add(1, std::memory_order_relaxed);
+    if (chance) shoe.remove(_nodes[bestChild].point);
     node = bestChild;
   }
 }
 
-double mcts::Node::getUCBValue() const {
-  if (visits == 0) return std::numeric_limits<double>::max();
+mcts::NodeId mcts::MCTS::_selectAction(NodeId node) const {
+  NodeId bestChild = NO_NODE;
+
+  std::uint32_t parentVisits =
+      _nodes[node].visits.load() + _nodes[node].virtualLoss.load();
+  double maxUCBValue = std::numeric_limits<double>::lowest();
+  for (NodeId child : _nodes[node].children) {
+    if (child == NO_NODE) continue;
+    double ucbValue = _nodes[child].getUCBValue(parentVisits);
+    if (bestChild == NO_NODE || ucbValue > maxUCBValue) {
+      bestChild = child;
+      maxUCBValue = ucbValue;
+    }
+  }
+  return bestChild;
+}
+
+mcts::NodeId mcts::MCTS::_selectOutcome(NodeId node, const Shoe& shoe) const {
+  if (shoe.empty()) return NO_NODE;
+
+  // 分層抽樣：每種牌被選到的比例跟抽到的機率一樣，但不用亂數，
+  // 少見的牌也不會因為運氣差很久都沒被選到。virtual loss 也算進去，
+  // 多條執行緒同時經過時會分到不同的牌
+  double total = _nodes[node].visits.load(std::memory_order_relaxed) +
+                 _nodes[node].virtualLoss.load(std::memory_order_relaxed);
+
+  NodeId bestChild = NO_NODE;
+  double maxDeficit = std::numeric_limits<double>::lowest();
+  for (int point = 1; point <= MAX_OUTCOMES; point++) {
+    NodeId child = _nodes[node].children[point - 1];
+    if (child == NO_NODE || shoe.count(point) == 0) continue;
+
+    double expected = total * shoe.count(point) / shoe.size();
+    double actual = _nodes[child].visits.load(std::memory_order_relaxed) +
+                    _nodes[child].virtualLoss.load(std::memory_order_relaxed);
+    if (bestChild == NO_NODE || expected - actual > maxDeficit) {
+      bestChild = child;
+      maxDeficit = expected - actual;
+    }
+  }
+  return bestChild;
+}
+
+double mcts::MCTS::_expectedValue(NodeId node, const Shoe& shoe,
+                                  double fallback) const {
+  double weighted = 0;
+  double probability = 0;
+  for (int point = 1; point <= MAX_OUTCOMES; point++) {
+    NodeId child = _nodes[node].children[point - 1];
+    if (child == NO_NODE || shoe.count(point) == 0) continue;
+
+    std::uint32_t visits = _nodes[child].visits.load(std::memory_order_relaxed);
+    if (visits == 0) continue;
+
+    double p = static_cast<double>(shoe.count(point)) / shoe.size();
+    weighted += p * _nodes[child].value.load(std::memory_order_relaxed) / visits;
+    probability += p;
+  }
+  return probability > 0 ? weighted / probability : fallback;
+}
+
+double mcts::Node::getUCBValue(std::uint32_t parentVisits) const {
+  // virtual loss 算成價值為 0 的訪問
+  std::uint32_t count = visits.load(std::memory_order_relaxed) +
+                        virtualLoss.load(std::memory_order_relaxed);
+  if (count == 0) return std::numeric_limits<double>::max();
 
   const double explorationConstant = 1.414;
 
-  return (value / visits) +
-         (explorationConstant * sqrt(log(parent->visits) / visits));
+  return (value.load(std::memory_order_relaxed) / count) +
+         (explorationConstant * sqrt(log(parentVisits) / count));
+}
+
+bool mcts::MCTS::_isLegal(NodeId node, Action action) const {
+  // 還沒要過牌也沒買保險，手上只有前兩張牌
+  bool isInitialStage = _rootHand.cardCount == 2 &&
+                        _nodes[node].drawCount == _nodes[root].drawCount &&
+                        !_nodes[node].insured;
+
+  switch (action) {
+    case Action::HIT:
+    case Action::STAND:
+      return true;
+    // 雙倍下注和投降只能在初始階段使用
+    case Action::DOUBLE:
+    case Action::SURRENDER:
+      return isInitialStage;
+    // 保險只能在莊家首牌為A且在初始階段使用
+    case Action::INSURANCE:
+      return isInitialStage &&
+             dealerVisibleCards.front().getRank() == Poker::ACE;
+  }
+  return false;
 }
 
-void mcts::MCTS::expansion(std::shared_ptr<Node> node) {
+bool mcts::MCTS::_isTerminal(NodeId node) const {
+  // 機會節點還要看抽到哪張牌
+  if (_nodes[node].chance) return false;
+
+  Action nodeAction = _nodes[node].action;
+
   // 終止條件：這些動作會結束回合
-  if (node->action == Action::SURRENDER || node->action == Action::DOUBLE ||
-      node->action == Action::STAND)
-    return;
+  if (node != root &&
+      (nodeAction == Action::SURRENDER || nodeAction == Action::DOUBLE ||
+       nodeAction == Action::STAND))
+    return true;
 
   // 爆牌情況
-  if (Poker::getPokerValue(node->pokers) > 21) return;
+  HandState hand;
+  Shoe shoe;
+  _stateAt(node, hand, shoe);
+  return hand.isBust();
+}
 
-  // 檢查是否在遊戲初始階段（只有前兩張牌）
-  bool isInitialStage = node->pokers.size() == 2;
+void mcts::MCTS::expansion(NodeId node) {
+  // 根節點在 advance 之後可能要補上子節點，其他節點只展開一次
+  std::uint8_t state = Node::UNEXPANDED;
+  if (!_nodes[node].expandState.compare_exchange_strong(state,
+                                                        Node::EXPANDING) &&
+      node != root)
+    return;
 
-  // 其他動作的原始處理邏輯
-  for (int i = 0; i < MAX_CHILDREN; ++i) {
-    Action currentAction = static_cast<Action>(i);
+  if (_isTerminal(node)) {
+    _nodes[node].expandState.store(Node::EXPANDED, std::memory_order_release);
+    return;
+  }
 
-    // 根據遊戲階段和當前狀態檢查動作合法性
+  if (_nodes[node].chance) {
+    // 牌靴裡還有的牌值各建一個子節點
+    HandState hand;
+    Shoe shoe;
+    _stateAt(node, hand, shoe);
+    for (int point = 1; point <= MAX_OUTCOMES; ++point) {
+      if (_nodes[node].children[point - 1] != NO_NODE) continue;
+      if (shoe.count(point) == 0) continue;
 
-    // 保險只能在莊家首牌為A且在初始階段使用
-    if (currentAction == Action::INSURANCE) {
-      if (dealerVisibleCards.front().getNumber() != "A" || !isInitialStage ||
-          node->action == Action::INSURANCE || node->action == Action::HIT)
-        continue;
+      NodeId child =
+          _newNode(node, Action::HIT, static_cast<std::uint8_t>(point));
+      _nodes[node].children[point - 1] = child;
     }
 
-    // 雙倍下注只能在初始階段使用，且不能在HIT或INSURANCE之後
-    if (currentAction == Action::DOUBLE) {
-      if (!isInitialStage || node->action == Action::HIT ||
-          node->action == Action::INSURANCE)
-        continue;
-    }
+    _nodes[node].expandState.store(Node::EXPANDED, std::memory_order_release);
+    return;
+  }
 
-    // 投降只能在初始階段使用，且不能在HIT或INSURANCE之後
-    if (currentAction == Action::SURRENDER) {
-      if (!isInitialStage || node->action == Action::HIT ||
-          node->action == Action::INSURANCE)
-        continue;
-    }
+  for (int i = 0; i < MAX_CHILDREN; ++i) {
+    Action currentAction = static_cast<Action>(i);
+
+    if (_nodes[node].children[i] != NO_NODE) continue;
+    if (!_isLegal(node, currentAction)) continue;
 
     // 建立子節點
-    auto child = std::make_shared<Node>();
-    child->parent = node;
-    child->action = currentAction;
-    child->cardPool = node->cardPool;
-    child->pokers = node->pokers;
-    child->value = 0;
-    child->drawCount = node->drawCount + 1;
-    child->visits = 0;
-    node->children[i] = child;
+    NodeId child = _newNode(node, currentAction);
+    _nodes[node].children[i] = child;
   }
+
+  _nodes[node].expandState.store(Node::EXPANDED, std::memory_order_release);
 }
 
-void mcts::MCTS::backpropagation(std::shared_ptr<Node> node, double result) {
-  while (node != nullptr) {
-    node->visits++;
-    node->value += result;
-    node = node->parent;
+void mcts::MCTS::backpropagation(NodeId node, double result) {
+  HandState hand;
+  Shoe shoe;
+  _stateAt(node, hand, shoe);
+
+  // 平方和一律用葉節點的原始結果：換成加權平均的話，平方和只剩收斂中的
+  // 平均值本身的變化，提早停止的信賴區間會窄到不成立
+  const double sample = result;
+
+  while (node != NO_NODE) {
+    Node& current = _nodes[node];
+    // 機會節點的價值是各種牌依機率加權的平均，往上也傳這個平均，
+    // 而不是這次抽到的那張牌的結果，上面的節點的平均值不會被單一張牌的運氣影響
+    if (current.chance) {
+      result = _expectedValue(node, shoe, result);
+      current.setMean(result, sample);
+    } else {
+      current.addResult(result, sample);
+    }
+    assert(current.virtualLoss.load(std::memory_order_relaxed) > 0);
+    current.virtualLoss.fetch_sub(1, std::memory_order_relaxed);
+
+    // 回到機會節點時把抽到的牌放回牌靴
+    if (current.point != 0) shoe.add(current.point);
+    node = current.parent;
   }
 }
 
-double mcts::MCTS::playout(std::shared_ptr<Node> node) {
-  double totalResult = 0.0;
+double mcts::MCTS::playout(NodeId nodeId) { return _playout(nodeId, _stats); }
 
-  // 決定要使用的線程數量
-  unsigned int numThreads = std::thread::hardware_concurrency();
-  numThreads = numThreads > 0 ? numThreads : 4;  // 如果無法檢測，預設為4
-  numThreads = std::min(
-      numThreads, (unsigned int)_playoutTimes);  // 不要創建比模擬次數更多的線程
+double mcts::MCTS::_playout(NodeId nodeId, SearchStats& stats) {
+  Clock::time_point start = Clock::now();
+  const std::thread::id caller = std::this_thread::get_id();
+  std::atomic<std::uint64_t> simulateNs(0);
+  // 只有呼叫的執行緒會寫
+  std::uint64_t callerNs = 0;
 
-  std::vector<std::thread> threads;
+  // 不要創建比模擬次數更多的任務
+  int numTasks = std::min(_threadCount(), _config.playoutsPerLeaf);
 
-  // 平均分配工作給每個線程
-  int playoutsPerTask = _playoutTimes / numThreads;
-  int remainingPlayouts = _playoutTimes % numThreads;
+  // 平均分配工作給每個任務
+  int playoutsPerTask = _config.playoutsPerLeaf / numTasks;
+  int remainingPlayouts = _config.playoutsPerLeaf % numTasks;
 
-  // 創建任務和存儲 future 來獲取結果
-  std::vector<std::future<double>> results;
+  // 每次 playout 呼叫的每個任務各用一條串流，不共用亂數產生器
+  std::uint64_t streamBase = _nextStream;
+  _nextStream += numTasks;
 
-  auto taskFunction = [this, node](int playoutCount) {
-    double taskResult = 0;
+  double totalResult = _pool().parallel_reduce(
+      0, numTasks, 1, 0.0,
+      [&](std::size_t i) {
+        Clock::time_point taskStart = Clock::now();
+        Xoshiro256 rng = Xoshiro256::forStream(_config.seed, streamBase + i);
+        int playoutCount =
+            playoutsPerTask + (i == 0 ? remainingPlayouts : 0);
+        double result = _simulate(nodeId, playoutCount, rng);
 
-    for (int i = 0; i < playoutCount; i++) {
-      // 為每次模擬建立所需資料的副本
-      auto cardPoolCopy = node->cardPool;
-      auto playerPokersCopy = node->pokers;  // 複製玩家的牌，避免修改原始數據
+        std::uint64_t elapsed = lap(taskStart);
+        simulateNs.fetch_add(elapsed, std::memory_order_relaxed);
+        if (std::this_thread::get_id() == caller) callerNs += elapsed;
+        return result;
+      },
+      std::plus<double>());
 
-      // 洗牌
-      std::shuffle(cardPoolCopy.begin(), cardPoolCopy.end(), _rng);
+  // 整段時間扣掉呼叫的執行緒自己在模擬的時間，就是在等其他線程
+  std::uint64_t wall = lap(start);
+  stats.playouts += _config.playoutsPerLeaf;
+  stats.playoutNs += simulateNs.load(std::memory_order_relaxed);
+  stats.playoutWaitNs += wall > callerNs ? wall - callerNs : 0;
 
-      auto dealerVisibleCardsCopy = dealerVisibleCards;
+  return totalResult / _config.playoutsPerLeaf;
+}
 
-      // 模擬莊家的牌
-      if (dealerVisibleCardsCopy.size() == 1 && !cardPoolCopy.empty()) {
-        dealerVisibleCardsCopy.push_back(cardPoolCopy.back());
-        cardPoolCopy.pop_back();
-      }
+double mcts::MCTS::_simulate(NodeId nodeId, int playoutCount,
+                             Xoshiro256& rng) const {
+  const Node& node = _nodes[nodeId];
+  if (node.action == Action::SURRENDER) return playoutCount * SURRENDER_VALUE;
 
-      // 根據動作模擬玩家的牌
-      double result = 0;
-      switch (node->action) {
-        case Action::HIT:
-          for(int j = 0; j < node->drawCount; j++) {
-            if (!cardPoolCopy.empty()) {
-              playerPokersCopy.push_back(cardPoolCopy.back());
-              cardPoolCopy.pop_back();
-            }
-          }
-          break;
-        case Action::STAND:
-          break;
-        case Action::DOUBLE:
-          playerPokersCopy.push_back(cardPoolCopy.back());
-          cardPoolCopy.pop_back();
-          break;
-        case Action::SURRENDER:
-          taskResult += SURRENDER_VALUE;
-          continue;
-        case Action::INSURANCE:
-          break;
-      }
+  const HandState dealerBaseHand = HandState::of(dealerVisibleCards);
 
-      int playerScore = Poker::getPokerValue(playerPokersCopy);
-      int dealerScore = Poker::getPokerValue(dealerVisibleCardsCopy);
-
-      // 莊家策略：抽牌直到硬17點或更高，軟17需繼續抽牌 (H17規則)
-      while ((dealerScore < 17 || 
-       (dealerScore == 17 && 
-        [&dealerVisibleCardsCopy]() {
-          // 內嵌判斷是否為軟17的邏輯
-          bool hasAce = false;
-          int sum = 0;
-          for ( auto& card : dealerVisibleCardsCopy) {
-            if (card.getNumber() == "A") {
-              hasAce = true;
-              sum += 1; // 先將A計為1點
-            } else if (card.getNumber() == "J" || card.getNumber() == "Q" || 
-                      card.getNumber() == "K") {
-              sum += 10;
-            } else {
-              sum += std::stoi(card.getNumber());
-            }
-          }
-          // 檢查是否為軟17：有A且將一張A計為11點後總和為17
-          return hasAce && (sum + 10 == 17);
-        }())) 
-      && !cardPoolCopy.empty()) {
-        dealerVisibleCardsCopy.push_back(cardPoolCopy.back());
-        cardPoolCopy.pop_back();
-        dealerScore = Poker::getPokerValue(dealerVisibleCardsCopy);
-      }
+  // 路徑上已經抽到的牌由樹決定，模擬只需要補上還沒看到的牌
+  HandState baseHand;
+  Shoe baseShoe;
+  _stateAt(nodeId, baseHand, baseShoe);
 
-      // 莊家有黑傑克
-      if (dealerScore == 21 && dealerVisibleCardsCopy.size() == 2) {
-        // 玩家有無保險
-        if (node->action == Action::INSURANCE) {
-          result = INSURANCE_SUCCESS_VALUE;
-        } else {
-          result = node->action == Action::DOUBLE ? DOUBLE_LOSE_VALUE
-                                                  : NORMAL_LOSE_VALUE;
-        }
-      } else {
-        // 檢查五張牌查理 (Five Card Charlie)
-        if (playerScore <= 21 && playerPokersCopy.size() == 5) {
-          result = node->action == Action::DOUBLE ? DOUBLE_WIN_VALUE
-                                                  : SPECIAL_WIN_VALUE;
-        }
-        // 檢查順子 (6-7-8)
-        else if (playerScore == 21 && playerPokersCopy.size() == 3) {
-          // 檢查是否為 6-7-8 順子
-          bool has6 = false, has7 = false, has8 = false;
-          for (auto& poker : playerPokersCopy) {
-            if (poker.getNumber() == "6")
-              has6 = true;
-            else if (poker.getNumber() == "7")
-              has7 = true;
-            else if (poker.getNumber() == "8")
-              has8 = true;
-          }
-          if (has6 && has7 && has8) {
-            result = node->action == Action::DOUBLE ? DOUBLE_WIN_VALUE
-                                                    : SPECIAL_WIN_VALUE;
-          } else {
-            // 非順子的情況，繼續正常評估
-            if (playerScore > 21) {  // 玩家爆牌
-              result = node->action == Action::DOUBLE ? DOUBLE_LOSE_VALUE
-                                                      : NORMAL_LOSE_VALUE;
-            } else if (playerScore == 21 &&
-                       playerPokersCopy.size() == 2) {  // 玩家黑傑克
-              result = node->action == Action::DOUBLE ? DOUBLE_WIN_VALUE
-                                                      : SPECIAL_WIN_VALUE;
-            } else if (playerScore > dealerScore) {  // 玩家點數高
-              result = node->action == Action::DOUBLE ? DOUBLE_WIN_VALUE
-                                                      : NORMAL_WIN_VALUE;
-            } else if (playerScore < dealerScore) {  // 莊家點數高
-              result = node->action == Action::DOUBLE ? DOUBLE_LOSE_VALUE
-                                                      : NORMAL_LOSE_VALUE;
-            } else {
-              result = DRAW_VALUE;
-            }
-          }
-        } else {
-          // 正常評估
-          if (playerScore > 21) {  // 玩家爆牌
-            result = node->action == Action::DOUBLE ? DOUBLE_LOSE_VALUE
-                                                    : NORMAL_LOSE_VALUE;
-          } else if (dealerScore > 21) {  // 莊家爆牌
-            result = node->action == Action::DOUBLE ? DOUBLE_WIN_VALUE
-                                                    : NORMAL_WIN_VALUE;
-          } else if (playerScore == 21 &&
-                     playerPokersCopy.size() == 2) {  // 玩家黑傑克
-            result = node->action == Action::DOUBLE ? DOUBLE_WIN_VALUE
-                                                    : SPECIAL_WIN_VALUE;
-          } else if (playerScore > dealerScore) {  // 玩家點數高
-            result = node->action == Action::DOUBLE ? DOUBLE_WIN_VALUE
-                                                    : NORMAL_WIN_VALUE;
-          } else if (playerScore < dealerScore) {  // 莊家點數高
-            result = node->action == Action::DOUBLE ? DOUBLE_LOSE_VALUE
-                                                    : NORMAL_LOSE_VALUE;
-          } else {  // 平局
-            result = DRAW_VALUE;
-          }
-        }
+  // 只看得到明牌時可以直接用精確的莊家分佈，底牌留在牌靴裡
+  const bool exactDealer =
+      _config.exactDealer && dealerVisibleCards.size() == 1;
 
-        if (node->action == Action::INSURANCE) {
-          result -= INSURANCE_FAIL_VALUE;
-        }
+  // 逐張抽牌模擬莊家時要先補上底牌
+  const bool sampleHole =
+      !exactDealer && dealerVisibleCards.size() == 1 && !baseShoe.empty();
+
+  const bool doubled = node.action == Action::DOUBLE;
+
+  // 機會節點要的那張牌還沒看到，加倍也要再拿一張
+  const int draws = (node.chance ? 1 : 0) + (doubled ? 1 : 0);
+
+  // 停牌、加倍和爆牌之後不能再要牌，其他葉節點交給模擬策略繼續玩
+  const bool playable = !doubled && !_isTerminal(nodeId);
+  const RolloutPolicy& policy = _rollout();
+  const int dealerPoint = RANK_POINT[dealerVisibleCards.front().getRank()];
+
+  DrawSequence sequence(rng, _config.antitheticDraws);
+
+  // 一次模擬的價值；hole 為底牌的牌值，0 表示隨機抽
+  auto playout = [&](int hole) {
+    sequence.next();
+
+    // 每次模擬只複製牌靴的點數計數，不需要洗牌
+    Shoe shoe = baseShoe;
+    HandState playerHand = baseHand;
+    HandState dealerHand = dealerBaseHand;
+
+    // 模擬莊家的牌
+    if (sampleHole) {
+      if (hole == 0) {
+        hole = sequence.draw(shoe);
+      } else {
+        shoe.remove(hole);
       }
+      dealerHand.addPoint(hole);
+    }
+
+    for (int j = 0; j < draws && !shoe.empty(); j++) {
+      playerHand.addPoint(sequence.draw(shoe));
+    }
 
-      if (result < 0) result = 0;
+    for (int hits = 0; playable && !playerHand.isBust() && !shoe.empty() &&
+                       policy.hit(playerHand, dealerPoint, hits, rng);
+         hits++) {
+      playerHand.addPoint(sequence.draw(shoe));
+    }
 
-      taskResult += result;
+    if (exactDealer) {
+      const DealerDistribution& odds = DealerOdds::threadLocal().distribution(
+          dealerBaseHand.hardTotal, shoe);
+      double result = 0;
+      for (int r = DEALER_17; r <= DEALER_21; r++) {
+        result += odds[r] * score(doubled, node.insured, playerHand, false,
+                                  false, 17 + r);
+      }
+      result += odds[DEALER_BUST] *
+                score(doubled, node.insured, playerHand, false, true, 0);
+      result += odds[DEALER_BLACKJACK] *
+                score(doubled, node.insured, playerHand, true, false, 21);
+      return result;
     }
-    return taskResult;
+
+    // 莊家策略：抽牌直到硬17點或更高，軟17需繼續抽牌 (H17規則)
+    while (dealerHand.dealerShouldHit() && !shoe.empty()) {
+      dealerHand.addPoint(sequence.draw(shoe));
+    }
+
+    return score(doubled, node.insured, playerHand, dealerHand.isBlackjack(),
+                 dealerHand.isBust(), dealerHand.total());
   };
 
-  // 提交任務到線程池
-  for (unsigned int i = 0; i < numThreads - 1; i++) {
-    results.emplace_back(_threadPool->enqueue(taskFunction, playoutsPerTask));
+  // 精確莊家分佈下不用抽牌的葉節點(停牌、爆牌)每次模擬結果都一樣
+  if (exactDealer && draws == 0 && !playable) {
+    return playout(0) * playoutCount;
   }
-  results.emplace_back(
-      _threadPool->enqueue(taskFunction, playoutsPerTask + remainingPlayouts));
 
-  // 收集結果
-  for (auto& future : results) {
-    totalResult += future.get();
+  double totalResult = 0;
+
+  std::array<int, Shoe::POINTS> strata;
+  if (sampleHole && _config.stratifiedHoleCard &&
+      allocateStrata(baseShoe, playoutCount, strata)) {
+    // 每層的平均依底牌的機率加權，再換回 playoutCount 次模擬的總和
+    for (int point = 1; point <= Shoe::POINTS; point++) {
+      int count = strata[point - 1];
+      if (count == 0) continue;
+
+      sequence.restart();
+      double stratum = 0;
+      for (int i = 0; i < count; i++) stratum += playout(point);
+
+      double probability =
+          static_cast<double>(baseShoe.count(point)) / baseShoe.size();
+      totalResult += probability * playoutCount * stratum / count;
+    }
+    return totalResult;
   }
 
-  return totalResult / _playoutTimes;
-}
\ No newline at end of file
+  for (int i = 0; i < playoutCount; i++) totalResult += playout(0);
+  return totalResult;
+}
@@ -59,6 +59,10 @@ void Player::out() { this->_isOut = true; }
 
 std::string Player::getName() { return _name; }
 
+bool Player::isBanker() { return _isBanker; }
+
+bool Player::isOut() { return _isOut; }
+
 void Player::addPoker(Poker poker) { _pokers.push_back(poker); }
 
 void Player::clearPoker() { _pokers.clear(); }
@@ -113,31 +117,6 @@ void Player::surrender() {
 
 std::vector<Poker>& Player::getPokers() { return _pokers; }
 
-int Player::getPoint() {
-  int point = 0;
-  int count = 0;
-  for (auto poker : _pokers) {
-    if (!poker._isFaceUp) continue;
-    if (poker.getNumber() == "A") {
-      count++;
-      continue;
-    }
-    if (poker.getNumber() == "J" || poker.getNumber() == "Q" ||
-        poker.getNumber() == "K") {
-      point += 10;
-    } else {
-      point += std::stoi(poker.getNumber());
-    }
-  }
-
-  while (count > 0) {
-    if (point + count * 11 > 21) {
-      point += 1;
-    } else {
-      point += 11;
-    }
-    count--;
-  }
+int Player::getPoint() { return getHand().total(); }
 
-  return point;
-}
\ No newline at end of file
+HandState Player::getHand() { return HandState::of(_pokers); }
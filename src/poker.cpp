@@ -2,166 +2,51 @@
 
 #include <iostream>
 #include <vector>
+
+#include "card_art.h"
 #define RED "\033[31;1m"
 #define DEFAULT "\033[0;1m"
 #define WHITE "\033[1;37m"
 
-Poker::Poker(Suit suit, std::string number)
-    : _isFaceUp(true), _suit(suit), _number(number) {}
+namespace {
 
-Poker::Poker() : _isFaceUp(true) {}
+const char* const NUMBERS[14] = {"",  "A", "2", "3",  "4", "5", "6",
+                                 "7", "8", "9", "10", "J", "Q", "K"};
 
-void Poker::showAttribute() { std::cout << _suit << " " << _number << "\n"; }
+int parseNumber(const std::string& number) {
+  for (int rank = 1; rank <= 13; rank++) {
+    if (number == NUMBERS[rank]) return rank;
+  }
+  return 0;
+}
 
-Suit Poker::getSuit() { return _suit; }
+}  // namespace
 
-std::string Poker::getNumber() { return _number; }
+Poker::Poker(Suit suit, std::string number) : Poker(suit, parseNumber(number)) {}
 
-std::vector<std::string> Poker::getPattern() {
-  return (_isFaceUp) ? _picture : _backPattern;
-}
+Poker::Poker(Suit suit, int rank)
+    : _bits(static_cast<std::uint8_t>(FACE_UP_BIT | ((suit & 0x3) << 4) |
+                                      (rank & 0xF))) {}
 
-void Poker::setNumber(std::string number) { _number = number; }
+Poker::Poker() : _bits(FACE_UP_BIT) {}
 
-void Poker::flipTheCard() { this->_isFaceUp = !this->_isFaceUp; }
+void Poker::showAttribute() const {
+  std::cout << getSuit() << " " << getNumber() << "\n";
+}
 
-void Poker::setSuit(Suit suit) {
-  _suit = suit;
-  _backPattern.push_back("-----------------");
-  _backPattern.push_back("|***************|");
-  _backPattern.push_back("|***************|");
-  _backPattern.push_back("|***************|");
-  _backPattern.push_back("|***************|");
-  _backPattern.push_back("|***************|");
-  _backPattern.push_back("|***************|");
-  _backPattern.push_back("|***************|");
-  _backPattern.push_back("|***************|");
-  _backPattern.push_back("|***************|");
-  _backPattern.push_back("|***************|");
-  _backPattern.push_back("|***************|");
-  _backPattern.push_back("|***************|");
-  _backPattern.push_back("|***************|");
-  _backPattern.push_back("|***************|");
-  _backPattern.push_back("|***************|");
-  _backPattern.push_back("|***************|");
-  _backPattern.push_back("|***************|");
-  _backPattern.push_back("|***************|");
-  _backPattern.push_back("|***************|");
-  _backPattern.push_back("|***************|");
-  _backPattern.push_back("-----------------");
-  switch (_suit) {
-    case spade:
-      _picture.push_back("-----------------");
-      (_number == "10") ? _picture.push_back("|10             |")
-                        : _picture.push_back("|" + _number + "              |");
-      _picture.push_back("|       *       |");
-      _picture.push_back("|      ***      |");
-      _picture.push_back("|     *****     |");
-      _picture.push_back("|    *******    |");
-      _picture.push_back("|   *********   |");
-      _picture.push_back("|  ***********  |");
-      _picture.push_back("| ************* |");
-      _picture.push_back("|***************|");
-      _picture.push_back("|***************|");
-      _picture.push_back("|***************|");
-      _picture.push_back("|***************|");
-      _picture.push_back("| ************* |");
-      _picture.push_back("|  ***********  |");
-      _picture.push_back("|   *** * ***   |");
-      _picture.push_back("|       *       |");
-      _picture.push_back("|      ***      |");
-      _picture.push_back("|     *****     |");
-      _picture.push_back("|    *******    |");
-      (_number == "10") ? _picture.push_back("|             10|")
-                        : _picture.push_back("|              " + _number + "|");
-      _picture.push_back("-----------------");
-      break;
-    case heart:
-      _picture.push_back("-----------------");
-      (_number == "10") ? _picture.push_back("|10             |")
-                        : _picture.push_back("|" + _number + "              |");
-      _picture.push_back("|               |");
-      _picture.push_back("|   ***   ***   |");
-      _picture.push_back("|  ***** *****  |");
-      _picture.push_back("| ************* |");
-      _picture.push_back("|***************|");
-      _picture.push_back("|***************|");
-      _picture.push_back("|***************|");
-      _picture.push_back("| ************* |");
-      _picture.push_back("| ************* |");
-      _picture.push_back("|  ***********  |");
-      _picture.push_back("|  ***********  |");
-      _picture.push_back("|   *********   |");
-      _picture.push_back("|   *********   |");
-      _picture.push_back("|    *******    |");
-      _picture.push_back("|     *****     |");
-      _picture.push_back("|     *****     |");
-      _picture.push_back("|      ***      |");
-      _picture.push_back("|       *       |");
-      (_number == "10") ? _picture.push_back("|             10|")
-                        : _picture.push_back("|              " + _number + "|");
-      _picture.push_back("-----------------");
-      break;
-    case diamond:
-      _picture.push_back("-----------------");
-      (_number == "10") ? _picture.push_back("|10             |")
-                        : _picture.push_back("|" + _number + "              |");
-      _picture.push_back("|               |");
-      _picture.push_back("|               |");
-      _picture.push_back("|       *       |");
-      _picture.push_back("|      ***      |");
-      _picture.push_back("|     *****     |");
-      _picture.push_back("|    *******    |");
-      _picture.push_back("|   *********   |");
-      _picture.push_back("|  ***********  |");
-      _picture.push_back("| ************* |");
-      _picture.push_back("|***************|");
-      _picture.push_back("| ************* |");
-      _picture.push_back("|  ***********  |");
-      _picture.push_back("|   *********   |");
-      _picture.push_back("|    *******    |");
-      _picture.push_back("|     *****     |");
-      _picture.push_back("|      ***      |");
-      _picture.push_back("|       *       |");
-      _picture.push_back("|               |");
-      (_number == "10") ? _picture.push_back("|             10|")
-                        : _picture.push_back("|              " + _number + "|");
-      _picture.push_back("-----------------");
-      break;
-    case club:
-      _picture.push_back("-----------------");
-      (_number == "10") ? _picture.push_back("|10             |")
-                        : _picture.push_back("|" + _number + "              |");
-      _picture.push_back("|               |");
-      _picture.push_back("|      ***      |");
-      _picture.push_back("|     *****     |");
-      _picture.push_back("|     *****     |");
-      _picture.push_back("|    *******    |");
-      _picture.push_back("|    *******    |");
-      _picture.push_back("|     *****     |");
-      _picture.push_back("|      ***      |");
-      _picture.push_back("|   **  *  **   |");
-      _picture.push_back("| ***** * ***** |");
-      _picture.push_back("|***************|");
-      _picture.push_back("|***************|");
-      _picture.push_back("|***************|");
-      _picture.push_back("| ***** * ***** |");
-      _picture.push_back("|   **  *  **   |");
-      _picture.push_back("|      ***      |");
-      _picture.push_back("|     *****     |");
-      _picture.push_back("|    *******    |");
-      (_number == "10") ? _picture.push_back("|             10|")
-                        : _picture.push_back("|              " + _number + "|");
-      _picture.push_back("-----------------");
-      break;
-  }
+std::string Poker::getNumber() const { return NUMBERS[getRank()]; }
+
+const std::vector<std::string>& Poker::getPattern() const {
+  if (!isFaceUp() || getRank() == 0) return card_art::back();
+  return card_art::front(getSuit(), getRank());
 }
 
-void Poker::printPokers(std::vector<Poker> pokers) {
+void Poker::printPokers(const std::vector<Poker>& pokers) {
+  if (pokers.empty()) return;
   for (int i = 0; i < pokers[0].getPattern().size(); i++) {
     for (auto& poker : pokers) {
       if ((poker.getSuit() == heart || poker.getSuit() == diamond) &&
-          poker._isFaceUp) {
+          poker.isFaceUp()) {
         std::cout << RED << poker.getPattern()[i] << DEFAULT << "  ";
       } else {
         std::cout << WHITE << poker.getPattern()[i] << DEFAULT << "  ";
@@ -173,7 +58,7 @@ void Poker::printPokers(std::vector<Poker> pokers) {
 }
 
 void Poker::printPokers(Poker poker) {
-  for (auto row : poker.getPattern()) {
-    std::cout<< row << "\n";
+  for (auto& row : poker.getPattern()) {
+    std::cout << row << "\n";
   }
-}
\ No newline at end of file
+}
@@ -0,0 +1,192 @@
+#include "renderer.h"
+
+#include <iostream>
+#include <string>
+
+#define DEFAULT "\033[0;1m"
+#define REDBACKGROUND "\033[41;1m"
+#define GREENBACKGROUND "\033[42;1m"
+
+TerminalRenderer &TerminalRenderer::standard() {
+  static TerminalRenderer renderer;
+  return renderer;
+}
+
+NullRenderer &NullRenderer::instance() {
+  static NullRenderer renderer;
+  return renderer;
+}
+
+void TerminalRenderer::message(const char *text) { std::cout << text << "\n"; }
+
+void TerminalRenderer::roundStart(int round) {
+  std::cout << "Round " << round << " start!"
+            << "\n";
+}
+
+void TerminalRenderer::bankerChosen(Player &banker) {
+  std::cout << REDBACKGROUND << "*** The banker is " << banker.getName()
+            << " ***" << DEFAULT << "\n";
+}
+
+void TerminalRenderer::table(Player &banker, std::vector<Player> &players) {
+  std::cout << banker.getName() << "(banker) "
+            << "points : " << banker.getPoint() << "\n";
+
+  Poker::printPokers(banker.getPokers());
+
+  for (auto &player : players) {
+    if (player.isBanker()) continue;
+    if (player.isOut()) continue;
+    std::cout << player.getName() << " points : " << player.getPoint() << "\n";
+    Poker::printPokers(player.getPokers());
+  }
+}
+
+void TerminalRenderer::turn(Player &player) {
+  std::cout << player.getName() << " : ";
+}
+
+void TerminalRenderer::action(PlayerAction action, int amount) {
+  std::cout << " has chosen to ";
+  switch (action) {
+    case PlayerAction::STAKE:
+      std::cout << "stake " << amount;
+      break;
+    case PlayerAction::DOUBLE_DOWN:
+      std::cout << "double down";
+      break;
+    case PlayerAction::SURRENDER:
+      std::cout << "surrender";
+      break;
+    case PlayerAction::NOTHING:
+      std::cout << "do nothing";
+      break;
+    case PlayerAction::INSURANCE:
+      std::cout << "take the insurance";
+      break;
+    case PlayerAction::NO_INSURANCE:
+      std::cout << "not take the insurance";
+      break;
+    case PlayerAction::STAND:
+      std::cout << "not hit";
+      break;
+  }
+  std::cout << "\n";
+}
+
+void TerminalRenderer::hand(Player &player, bool isBanker) {
+  // 跟原本的輸出一樣：玩家的冒號後面是兩個空白，莊家是一個
+  std::cout << player.getName()
+            << (isBanker ? "(banker) : has" : " :  has")
+            << " got these cards now:\n\n";
+  std::cout << "Point : " << player.getPoint() << "\n";
+  Poker::printPokers(player.getPokers());
+}
+
+void TerminalRenderer::hit(Player &player) {
+  std::cout << " has got these cards now:\n\n";
+  std::cout << "Point : " << player.getPoint() << "\n";
+  Poker::printPokers(player.getPokers());
+}
+
+void TerminalRenderer::reached21(Player &player) {
+  std::cout << player.getName() << " :  has reached 21 points\n";
+}
+
+void TerminalRenderer::busted(Player &player, bool isBanker) {
+  std::cout << player.getName()
+            << (isBanker ? "(banker) : has" : " :  has") << " busted.\n";
+}
+
+void TerminalRenderer::bankerStands(Player &banker) {
+  std::cout << banker.getName() << "(banker)"
+            << " : stands with " << banker.getPoint() << " points.\n";
+}
+
+void TerminalRenderer::roundResult(Player &banker,
+                                   std::vector<Player> &players,
+                                   std::vector<Player> &leaderboard) {
+  // change the color
+  std::cout << GREENBACKGROUND << "The result is:" << DEFAULT << "\n";
+
+  std::cout << banker.getName() << "(banker)"
+            << "have : " << banker.getMoney() << "dollars!\n"
+            << ((banker.getProfit() > 0) ? GREENBACKGROUND : REDBACKGROUND)
+            << "(" << ((banker.getProfit() > 0) ? "+" : "")
+            << banker.getProfit() << ")" << DEFAULT << "\n";
+  for (auto &player : players) {
+    if (player.isBanker()) continue;
+    if (player.isOut()) continue;
+
+    std::cout << player.getName() << "have : " << player.getMoney()
+              << "dollars!\n"
+              << ((player.getProfit() > 0) ? GREENBACKGROUND : REDBACKGROUND)
+              << "(" << ((player.getProfit() > 0) ? "+" : "")
+              << player.getProfit() << ")" << DEFAULT << "\n";
+  }
+
+  std::cout << GREENBACKGROUND << "The leaderboard is:" << DEFAULT << "\n";
+  int i = 1;
+  for (auto &player : leaderboard) {
+    std::cout << i++ << ":\n"
+              << player.getName() << " Money: " << player.getMoney() << "\n";
+  }
+}
+
+void TerminalRenderer::finalLeaderboard(std::vector<Player> &leaderboard) {
+  std::cout << GREENBACKGROUND << "The final leaderboard is:" << DEFAULT
+            << "\n";
+  int i = 1;
+  for (auto &player : leaderboard) {
+    std::cout << i++ << ":\n"
+              << player.getName() << (player.isOut() ? "(out)" : "")
+              << " Money: " << player.getMoney()
+              << ((player.getTotalProfit() > 0) ? GREENBACKGROUND
+                                                : REDBACKGROUND)
+              << "("
+              << (player.getTotalProfit() > 0
+                      ? "+" + std::to_string(player.getTotalProfit())
+                      : std::to_string(player.getTotalProfit()))
+              << ")" << DEFAULT << "\n";
+  }
+}
+
+void TerminalRenderer::kickedOut(Player &player, bool noMoney) {
+  std::cout << player.getName()
+            << (noMoney ? " has been kicked out!(no money)\n"
+                        : " has been kicked out!(can't afford the least bet)\n");
+}
+
+void TerminalRenderer::progress(long long done, long long total) {
+  // 計算進度百分比
+  int percentage = static_cast<int>(total == 0 ? 100 : done * 100 / total);
+
+  // 繪製進度條
+  std::cout << "\r[";
+  for (int j = 0; j < 50; j++) {
+    if (j < percentage / 2)
+      std::cout << "=";
+    else if (j == percentage / 2)
+      std::cout << ">";
+    else
+      std::cout << " ";
+  }
+  std::cout << "] " << done << "/" << total << " (" << percentage << "%)     ";
+  std::cout.flush();  // 確保立即顯示
+}
+
+void TerminalRenderer::simulationResult(const SimulationResult &result) {
+  // show the result
+  std::cout << "\nMCTS winrate: " << result.winRate() * 100 << "%"
+            << std::endl;
+
+  std::cout << "profit: " << result.profit << std::endl;
+
+  long long lookups = result.cacheHits + result.cacheMisses;
+  if (lookups > 0) {
+    std::cout << "decision cache hits: " << result.cacheHits << "/" << lookups
+              << " (" << result.cacheHits * 100.0 / lookups << "%)"
+              << std::endl;
+  }
+}
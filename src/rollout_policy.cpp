@@ -0,0 +1,21 @@
+#include "rollout_policy.h"
+
+#include <random>
+
+#include "basic_strategy.h"
+
+bool mcts::FixedCountPolicy::hit(const HandState&, int, int hits,
+                                 Xoshiro256&) const {
+  return hits < _count;
+}
+
+bool mcts::RandomPolicy::hit(const HandState& hand, int, int,
+                             Xoshiro256& rng) const {
+  if (hand.total() >= 21) return false;
+  return std::bernoulli_distribution(_hitProbability)(rng);
+}
+
+bool mcts::BasicStrategyPolicy::hit(const HandState& hand, int dealerPoint,
+                                    int, Xoshiro256&) const {
+  return basicStrategyHit(hand, dealerPoint);
+}
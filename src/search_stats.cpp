@@ -0,0 +1,35 @@
+#include "search_stats.h"
+
+#include <sstream>
+
+const char *stopReasonName(StopReason reason) {
+  switch (reason) {
+    case StopReason::ITERATIONS:
+      return "iterations";
+    case StopReason::PLAYOUTS:
+      return "playouts";
+    case StopReason::NODES:
+      return "nodes";
+    case StopReason::TIME:
+      return "time";
+    case StopReason::CONFIDENCE:
+      return "confidence";
+    case StopReason::CONVERGED:
+      return "converged";
+  }
+  return "unknown";
+}
+
+std::string SearchStats::toJson() const {
+  std::ostringstream json;
+  json << "{\"iterations\":" << iterations
+       << ",\"nodesAllocated\":" << nodesAllocated
+       << ",\"maxDepth\":" << maxDepth << ",\"playouts\":" << playouts
+       << ",\"selectionNs\":" << selectionNs
+       << ",\"expansionNs\":" << expansionNs
+       << ",\"playoutNs\":" << playoutNs
+       << ",\"backpropagationNs\":" << backpropagationNs
+       << ",\"playoutWaitNs\":" << playoutWaitNs << ",\"wallNs\":" << wallNs
+       << ",\"stopReason\":\"" << stopReasonName(stopReason) << "\"}";
+  return json.str();
+}
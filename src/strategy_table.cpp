@@ -0,0 +1,172 @@
+#include "strategy_table.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+
+#ifdef _WIN32
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+StrategyTable::StrategyTable(int decks, int minCount, int countBuckets)
+    : _mapping(nullptr), _mappedSize(0) {
+#ifdef _WIN32
+  _file = nullptr;
+  _mappingHandle = nullptr;
+#endif
+  countBuckets = std::max(1, countBuckets);
+  std::size_t entryCount = STATES_PER_BUCKET * countBuckets;
+  _owned.assign(sizeof(StrategyTableHeader) + entryCount, 0);
+
+  StrategyTableHeader header{};
+  std::memcpy(header.magic, MAGIC, sizeof(MAGIC));
+  header.version = VERSION;
+  header.decks = static_cast<std::uint16_t>(decks);
+  header.minCount = static_cast<std::int8_t>(minCount);
+  header.countBuckets = static_cast<std::uint8_t>(countBuckets);
+  header.entryCount = static_cast<std::uint32_t>(entryCount);
+  std::memcpy(_owned.data(), &header, sizeof(header));
+
+  _header = reinterpret_cast<const StrategyTableHeader*>(_owned.data());
+  _entries = _owned.data() + sizeof(StrategyTableHeader);
+}
+
+StrategyTable::StrategyTable(const std::string& path, int decks)
+    : _mapping(nullptr), _mappedSize(0) {
+#ifdef _WIN32
+  _file = nullptr;
+  _mappingHandle = nullptr;
+
+  HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ,
+                            nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL,
+                            nullptr);
+  if (file == INVALID_HANDLE_VALUE) {
+    throw std::runtime_error("cannot open strategy table " + path);
+  }
+  _file = file;
+
+  LARGE_INTEGER fileSize;
+  if (!GetFileSizeEx(file, &fileSize) || fileSize.QuadPart == 0) {
+    _unmap();
+    throw std::runtime_error("cannot read strategy table " + path);
+  }
+  _mappedSize = static_cast<std::size_t>(fileSize.QuadPart);
+
+  HANDLE mapping =
+      CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+  if (mapping == nullptr) {
+    _unmap();
+    throw std::runtime_error("cannot map strategy table " + path);
+  }
+  _mappingHandle = mapping;
+
+  _mapping = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+  if (_mapping == nullptr) {
+    _unmap();
+    throw std::runtime_error("cannot map strategy table " + path);
+  }
+#else
+  int fd = ::open(path.c_str(), O_RDONLY);
+  if (fd < 0) throw std::runtime_error("cannot open strategy table " + path);
+
+  struct stat status;
+  if (::fstat(fd, &status) != 0 || status.st_size == 0) {
+    ::close(fd);
+    throw std::runtime_error("cannot read strategy table " + path);
+  }
+  _mappedSize = static_cast<std::size_t>(status.st_size);
+
+  void* mapping = ::mmap(nullptr, _mappedSize, PROT_READ, MAP_SHARED, fd, 0);
+  // 映射建立後就不需要檔案描述子了
+  ::close(fd);
+  if (mapping == MAP_FAILED) {
+    throw std::runtime_error("cannot map strategy table " + path);
+  }
+  _mapping = mapping;
+#endif
+
+  _header = static_cast<const StrategyTableHeader*>(_mapping);
+  _entries = static_cast<const std::uint8_t*>(_mapping) +
+             sizeof(StrategyTableHeader);
+
+  bool valid =
+      _mappedSize >= sizeof(StrategyTableHeader) &&
+      std::memcmp(_header->magic, MAGIC, sizeof(MAGIC)) == 0 &&
+      _header->version == VERSION && _header->countBuckets > 0 &&
+      _header->entryCount == STATES_PER_BUCKET * _header->countBuckets &&
+      _mappedSize == sizeof(StrategyTableHeader) + _header->entryCount;
+  if (!valid) {
+    _unmap();
+    throw std::runtime_error("invalid strategy table " + path);
+  }
+
+  // 真數的 bucket 和每個狀態的期望值都跟牌的副數有關，不能混用
+  if (decks > 0 && _header->decks != decks) {
+    std::string built = std::to_string(_header->decks);
+    _unmap();
+    throw std::runtime_error("strategy table " + path + " was generated for " +
+                             built + " decks, not " + std::to_string(decks));
+  }
+}
+
+StrategyTable::~StrategyTable() { _unmap(); }
+
+void StrategyTable::_unmap() {
+#ifdef _WIN32
+  if (_mapping != nullptr) UnmapViewOfFile(_mapping);
+  if (_mappingHandle != nullptr) CloseHandle(_mappingHandle);
+  if (_file != nullptr) CloseHandle(_file);
+  _mappingHandle = nullptr;
+  _file = nullptr;
+#else
+  if (_mapping != nullptr) ::munmap(_mapping, _mappedSize);
+#endif
+  _mapping = nullptr;
+}
+
+int StrategyTable::countBucketOf(const Shoe& unseen) const {
+  if (_header->countBuckets == 1 || unseen.empty()) {
+    return std::clamp(-_header->minCount, 0, _header->countBuckets - 1);
+  }
+
+  // 整副牌的 2-6 和 10、A 一樣多，所以 Hi-Lo 的 running count
+  // 等於還沒出現的高牌減掉還沒出現的低牌
+  int low = 0;
+  for (int point = 2; point <= 6; point++) low += unseen.count(point);
+  int high = unseen.count(1) + unseen.count(10);
+
+  double trueCount = (high - low) / (unseen.size() / 52.0);
+  int bucket = static_cast<int>(std::lround(trueCount)) - _header->minCount;
+  return std::clamp(bucket, 0, _header->countBuckets - 1);
+}
+
+std::size_t StrategyTable::indexOf(const HandState& hand, int upcard,
+                                   int countBucket) const {
+  int total = std::clamp(hand.total(), 2, 21) - 2;
+  int cards = std::clamp(static_cast<int>(hand.cardCount), 2, 5) - 2;
+  int soft = hand.isSoft() ? 1 : 0;
+
+  std::size_t index = countBucket;
+  index = index * UPCARDS + (upcard - 1);
+  index = index * CARD_COUNTS + cards;
+  index = index * 2 + soft;
+  return index * TOTALS + total;
+}
+
+void StrategyTable::save(const std::string& path) const {
+  std::ofstream file(path, std::ios::binary | std::ios::trunc);
+  if (!file) throw std::runtime_error("cannot write strategy table " + path);
+
+  file.write(reinterpret_cast<const char*>(_header),
+             sizeof(StrategyTableHeader));
+  file.write(reinterpret_cast<const char*>(_entries), _header->entryCount);
+  if (!file) throw std::runtime_error("cannot write strategy table " + path);
+}
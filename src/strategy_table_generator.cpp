@@ -0,0 +1,109 @@
+#include "strategy_table_generator.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+
+namespace {
+
+using Representative = StrategyTableGenerator::Representative;
+
+void collectHands(HandState hand, std::vector<int>& points,
+                  std::vector<bool>& seen,
+                  std::vector<Representative>& hands) {
+  if (hand.cardCount >= 2) {
+    // 只看(點數, 軟牌, 張數)，明牌和 bucket 固定取第一個
+    static const StrategyTable layout(1, 0, 1);
+    std::size_t index = layout.indexOf(hand, 1, 0);
+    if (!seen[index]) {
+      seen[index] = true;
+      hands.push_back({hand, points});
+    }
+  }
+  if (hand.cardCount == 5 || hand.total() >= 21) return;
+
+  for (int point = 1; point <= Shoe::POINTS; point++) {
+    HandState next = hand;
+    next.addPoint(point);
+    if (next.isBust()) continue;
+    points.push_back(point);
+    collectHands(next, points, seen, hands);
+    points.pop_back();
+  }
+}
+
+}  // namespace
+
+std::vector<Representative> StrategyTableGenerator::representativeHands() {
+  std::vector<Representative> hands;
+  std::vector<bool> seen(StrategyTable::STATES_PER_BUCKET, false);
+  std::vector<int> points;
+  collectHands(HandState(), points, seen, hands);
+  return hands;
+}
+
+Shoe StrategyTableGenerator::shoeFor(int decks, int trueCount,
+                                     const std::vector<int>& points,
+                                     int upcard) {
+  Shoe shoe;
+  for (int point = 1; point <= 9; point++) shoe.add(point, 4 * decks);
+  shoe.add(10, 16 * decks);
+
+  auto take = [&shoe](int point) {
+    if (shoe.count(point) > 0) shoe.remove(point);
+  };
+  for (int point : points) take(point);
+  take(upcard);
+
+  int magnitude = std::abs(trueCount);
+  int removed = static_cast<int>(
+      std::lround(52.0 * decks * magnitude / (52.0 + magnitude)));
+  for (int i = 0; i < removed; i++) {
+    if (trueCount > 0) {
+      take(2 + i % 5);
+    } else {
+      // 10 點牌是 A 的四倍
+      take(i % 5 == 0 ? 1 : 10);
+    }
+  }
+  return shoe;
+}
+
+std::uint8_t StrategyTableGenerator::decisionOf(const ActionValues& values) {
+  std::uint8_t decision = 0;
+  double play = std::max(values.stand, values.hit);
+
+  if (values.hit > values.stand) decision |= StrategyTable::HIT;
+  if (values.doubleDown > play && values.doubleDown >= values.surrender) {
+    decision |= StrategyTable::DOUBLE;
+  } else if (values.surrender > play) {
+    decision |= StrategyTable::SURRENDER;
+  }
+  if (values.insurance > 0) decision |= StrategyTable::INSURANCE;
+  return decision;
+}
+
+std::size_t StrategyTableGenerator::fill(StrategyTable& table,
+                                         ThreadPool& pool) {
+  const int decks = table.header().decks;
+  const int minCount = table.header().minCount;
+  const int buckets = table.header().countBuckets;
+  const std::vector<Representative> hands = representativeHands();
+
+  // 每個任務各自一個 ExactSolver，只寫自己負責的那些 entry
+  pool.parallel_for(0, buckets * StrategyTable::UPCARDS, 1, [&](size_t job) {
+    int bucket = static_cast<int>(job / StrategyTable::UPCARDS);
+    int upcard = static_cast<int>(job % StrategyTable::UPCARDS) + 1;
+    int trueCount = minCount + bucket;
+
+    ExactSolver solver;
+    for (const auto& representative : hands) {
+      Shoe shoe = shoeFor(decks, trueCount, representative.points, upcard);
+      ActionValues values = solver.evaluate(representative.hand, upcard, shoe);
+      table.set(table.indexOf(representative.hand, upcard, bucket),
+                decisionOf(values));
+    }
+  });
+
+  return hands.size() * buckets * StrategyTable::UPCARDS;
+}
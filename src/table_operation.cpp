@@ -0,0 +1,30 @@
+#include "table_operation.h"
+
+std::uint8_t TableOperation::_lookup(const DecisionContext& context) const {
+  int upcard = RANK_POINT[context.dealerVisible[0].getRank()];
+  return _table.lookup(HandState::of(context.hand), upcard, context.unseen);
+}
+
+OpeningDecision TableOperation::doubleOrSurrender(
+    const DecisionContext& context) {
+  std::uint8_t decision = _lookup(context);
+
+  if (decision & StrategyTable::DOUBLE) {
+    return OpeningDecision::DOUBLE;
+  } else if (decision & StrategyTable::SURRENDER) {
+    return OpeningDecision::SURRENDER;
+  }
+  return OpeningDecision::NOTHING;
+}
+
+bool TableOperation::hit(const DecisionContext& context) {
+  return _lookup(context) & StrategyTable::HIT;
+}
+
+bool TableOperation::insurance(const DecisionContext& context) {
+  return _lookup(context) & StrategyTable::INSURANCE;
+}
+
+int TableOperation::stake(const DecisionContext& context) {
+  return context.table.leastBet;
+}
@@ -0,0 +1,27 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+
+#include "dealer.h"
+
+TEST(DealerTest, TestDrawTakesEveryCardOnce) {
+  Xoshiro256 rng(1);
+  std::vector<Poker> cardPool;
+  for (int i = 0; i < 4; i++) {
+    for (int j = 1; j <= 13; j++) {
+      cardPool.push_back(Poker(static_cast<Suit>(i), j));
+    }
+  }
+  std::vector<Poker> original = cardPool;
+
+  std::vector<Poker> drawn;
+  while (!cardPool.empty()) {
+    drawn.push_back(Dealer::draw(cardPool, rng));
+  }
+
+  EXPECT_EQ(drawn.size(), original.size());
+  for (auto poker : original) {
+    EXPECT_EQ(std::count(drawn.begin(), drawn.end(), poker), 1);
+  }
+  EXPECT_NE(drawn, original);
+}
@@ -0,0 +1,68 @@
+#include <gtest/gtest.h>
+
+#include <numeric>
+
+#include "dealer_odds.h"
+#include "rng.h"
+
+TEST(DealerOddsTest, TestSmallShoe) {
+  DealerOdds odds;
+
+  // 明牌10，牌靴只剩一張7：底牌一定是7，停在17點
+  Shoe seven;
+  seven.add(7);
+  EXPECT_DOUBLE_EQ(odds.distribution(10, seven)[DEALER_17], 1.0);
+
+  // 明牌10，牌靴剩A和10：一半黑傑克、一半20點
+  Shoe aceOrTen;
+  aceOrTen.add(1);
+  aceOrTen.add(10);
+  const DealerDistribution& result = odds.distribution(10, aceOrTen);
+  EXPECT_DOUBLE_EQ(result[DEALER_BLACKJACK], 0.5);
+  EXPECT_DOUBLE_EQ(result[DEALER_20], 0.5);
+
+  // 明牌A，底牌6是軟17，H17規則要再抽10變成硬17
+  Shoe soft17;
+  soft17.add(6);
+  soft17.add(10);
+  const DealerDistribution& h17 = odds.distribution(1, soft17);
+  EXPECT_DOUBLE_EQ(h17[DEALER_17], 0.5);
+  EXPECT_DOUBLE_EQ(h17[DEALER_BLACKJACK], 0.5);
+
+  EXPECT_EQ(odds.size(), 3);
+}
+
+TEST(DealerOddsTest, TestMatchesSimulation) {
+  Shoe shoe;
+  for (int point = 1; point <= 9; point++) shoe.add(point, 16);
+  shoe.add(10, 64);
+  shoe.remove(10);
+  shoe.remove(6);
+
+  for (int upcard : {1, 6, 10}) {
+    DealerDistribution exact = DealerOdds().distribution(upcard, shoe);
+    EXPECT_NEAR(std::accumulate(exact.begin(), exact.end(), 0.0), 1.0, 1e-9);
+
+    DealerDistribution sampled{};
+    Xoshiro256 rng(upcard);
+    const int trials = 200000;
+    for (int i = 0; i < trials; i++) {
+      Shoe copy = shoe;
+      HandState hand;
+      hand.addPoint(upcard);
+      while (hand.dealerShouldHit()) hand.addPoint(copy.draw(rng));
+
+      if (hand.isBlackjack()) {
+        sampled[DEALER_BLACKJACK] += 1.0 / trials;
+      } else if (hand.isBust()) {
+        sampled[DEALER_BUST] += 1.0 / trials;
+      } else {
+        sampled[DEALER_17 + hand.total() - 17] += 1.0 / trials;
+      }
+    }
+
+    for (int r = 0; r < DEALER_RESULTS; r++) {
+      EXPECT_NEAR(exact[r], sampled[r], 0.005);
+    }
+  }
+}
@@ -0,0 +1,196 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <chrono>
+
+#include "ai_operation.h"
+#include "decision_cache.h"
+#include "test_util.h"
+#include "thread_pool.h"
+
+namespace {
+
+mcts::ActionTable tableFor(mcts::Action best) {
+  mcts::ActionTable table{};
+  table[mcts::Action::HIT] = {true, 10, 0.4};
+  table[mcts::Action::STAND] = {true, 10, 0.4};
+  table[best].visits = 100;
+  return table;
+}
+
+}  // namespace
+
+TEST(DecisionCacheTest, TestShoeBucketing) {
+  DecisionCacheConfig config;
+  config.shoeBucket = 4;
+  DecisionCache cache(config);
+
+  // 63 張和 62 張 10 點牌除以 4 都是 15
+  Shoe shoe = fullShoe(4);
+  shoe.remove(10);
+  Shoe oneTenLess = shoe;
+  oneTenLess.remove(10);
+  Shoe manyTensLess = shoe;
+  for (int i = 0; i < 8; i++) manyTensLess.remove(10);
+
+  HandState hand = handOf({10, 6});
+  DecisionCache::Key key = cache.keyOf(hand, 10, false, shoe);
+
+  // 差一張牌落在同一個 bucket，差很多就不是同一個狀態
+  EXPECT_EQ(key, cache.keyOf(hand, 10, false, oneTenLess));
+  EXPECT_FALSE(key == cache.keyOf(hand, 10, false, manyTensLess));
+  // 手牌組成、明牌、保險不同都是不同的狀態
+  EXPECT_FALSE(key == cache.keyOf(handOf({9, 7}), 10, false, shoe));
+  EXPECT_FALSE(key == cache.keyOf(hand, 9, false, shoe));
+  EXPECT_FALSE(key == cache.keyOf(hand, 10, true, shoe));
+  // 同樣的點數但牌的順序不同是同一個狀態
+  EXPECT_EQ(key, cache.keyOf(handOf({6, 10}), 10, false, shoe));
+
+  config.shoeBucket = 1;
+  DecisionCache exact(config);
+  EXPECT_FALSE(exact.keyOf(hand, 10, false, shoe) ==
+               exact.keyOf(hand, 10, false, oneTenLess));
+}
+
+TEST(DecisionCacheTest, TestHitMissAndEviction) {
+  DecisionCacheConfig config;
+  config.capacity = 2;
+  config.shards = 1;
+  DecisionCache cache(config);
+  Shoe shoe = fullShoe(4);
+
+  DecisionCache::Key hard16 = cache.keyOf(handOf({10, 6}), 10, false, shoe);
+  DecisionCache::Key hard12 = cache.keyOf(handOf({10, 2}), 4, false, shoe);
+  DecisionCache::Key hard20 = cache.keyOf(handOf({10, 10}), 6, false, shoe);
+
+  mcts::ActionTable table;
+  EXPECT_FALSE(cache.find(hard16, table));
+  cache.insert(hard16, tableFor(mcts::Action::HIT));
+  cache.insert(hard12, tableFor(mcts::Action::STAND));
+
+  ASSERT_TRUE(cache.find(hard16, table));
+  EXPECT_EQ(mcts::bestAction(table, {mcts::Action::HIT, mcts::Action::STAND}),
+            mcts::Action::HIT);
+
+  // 滿了之後淘汰最久沒用到的 hard12
+  cache.insert(hard20, tableFor(mcts::Action::STAND));
+  EXPECT_EQ(cache.size(), 2u);
+  EXPECT_FALSE(cache.find(hard12, table));
+  EXPECT_TRUE(cache.find(hard16, table));
+  EXPECT_TRUE(cache.find(hard20, table));
+
+  DecisionCache::Stats stats = cache.stats();
+  EXPECT_EQ(stats.hits, 3u);
+  EXPECT_EQ(stats.misses, 2u);
+  EXPECT_EQ(stats.insertions, 3u);
+  EXPECT_EQ(stats.evictions, 1u);
+  EXPECT_DOUBLE_EQ(stats.hitRate(), 0.6);
+}
+
+TEST(DecisionCacheTest, TestCapacityWithManyShards) {
+  // 容量比分片數小時分片數跟著減少，存的狀態不會超過容量
+  DecisionCacheConfig config;
+  config.capacity = 3;
+  config.shards = 16;
+  DecisionCache cache(config);
+  Shoe shoe = fullShoe(4);
+
+  for (int upcard = 1; upcard <= 10; upcard++) {
+    cache.insert(cache.keyOf(handOf({10, 6}), upcard, false, shoe),
+                 tableFor(mcts::Action::HIT));
+  }
+  EXPECT_EQ(cache.size(), 3u);
+  EXPECT_EQ(cache.stats().insertions, 10u);
+  EXPECT_EQ(cache.stats().evictions, 7u);
+}
+
+TEST(DecisionCacheTest, TestInsuranceFromCacheKeepsInsuredSearch) {
+  DecisionCache cache;
+  ThreadPool pool(1);
+  AIOperation operation(7, pool, 1, &cache);
+  mcts::SearchLimits limits;
+  limits.iterations = 300;
+  operation.setSearchLimits(limits);
+
+  std::vector<Poker> hand = {Poker(heart, "10"), Poker(club, "6")};
+  std::vector<Poker> ace = {Poker(spade, "A")};
+  Shoe unseen = fullShoe(4);
+  unseen.remove(10);
+  unseen.remove(6);
+  unseen.remove(1);
+  TableContext tableContext{1000, 4};
+  DecisionContext context{hand, ace, unseen, 5000, tableContext};
+
+  // 保險的決策直接命中快取，沒有搜尋樹
+  mcts::ActionTable insure = tableFor(mcts::Action::STAND);
+  insure[mcts::Action::INSURANCE] = {true, 100, 0.5};
+  insure[mcts::Action::STAND].visits = 10;
+  operation.stake(context);
+  cache.insert(cache.keyOf(handOf({10, 6}), 1, false, unseen), insure);
+  ASSERT_TRUE(operation.insurance(context));
+
+  // 之後重新搜尋的樹要從買了保險的狀態開始，不能再加倍、投降或買保險
+  operation.hit(context);
+  mcts::ActionTable insured;
+  ASSERT_TRUE(cache.find(cache.keyOf(handOf({10, 6}), 1, true, unseen),
+                         insured));
+  EXPECT_TRUE(insured[mcts::Action::HIT].available);
+  EXPECT_FALSE(insured[mcts::Action::DOUBLE].available);
+  EXPECT_FALSE(insured[mcts::Action::SURRENDER].available);
+  EXPECT_FALSE(insured[mcts::Action::INSURANCE].available);
+}
+
+TEST(DecisionCacheTest, TestTimeLimitedSearchIsNotCached) {
+  DecisionCache cache;
+  ThreadPool pool(1);
+  std::vector<Poker> hand = {Poker(heart, "10"), Poker(club, "2")};
+  std::vector<Poker> ten = {Poker(spade, "K")};
+  Shoe unseen = fullShoe(4);
+  unseen.remove(10);
+  unseen.remove(2);
+  unseen.remove(10);
+  TableContext tableContext{1000, 4};
+  DecisionContext context{hand, ten, unseen, 5000, tableContext};
+
+  // 時間到才停的搜尋只拿來做這次決策
+  AIOperation hurried(7, pool, 1, &cache);
+  mcts::SearchLimits limits;
+  limits.iterations = 1000000;
+  limits.timeLimit = std::chrono::microseconds(1);
+  hurried.setSearchLimits(limits);
+  hurried.stake(context);
+  hurried.hit(context);
+  EXPECT_EQ(hurried.lastSearchStats().stopReason, StopReason::TIME);
+  EXPECT_EQ(cache.size(), 0u);
+
+  // 跑完預算的搜尋才存
+  AIOperation full(7, pool, 1, &cache);
+  limits = mcts::SearchLimits();
+  limits.iterations = 300;
+  full.setSearchLimits(limits);
+  full.stake(context);
+  full.hit(context);
+  EXPECT_EQ(cache.size(), 1u);
+}
+
+TEST(DecisionCacheTest, TestConcurrentAccess) {
+  DecisionCache cache;
+  ThreadPool pool(4);
+  Shoe shoe = fullShoe(4);
+
+  // 多條線程同時查同樣的狀態，每個狀態只會存一份
+  pool.parallel_for(0, 400, 8, [&](size_t i) {
+    int total = 4 + static_cast<int>(i % 17);
+    int first = std::min(10, total - 2);
+    DecisionCache::Key key =
+        cache.keyOf(handOf({first, total - first}), 10, false, shoe);
+    mcts::ActionTable table;
+    if (!cache.find(key, table)) {
+      cache.insert(key, tableFor(mcts::Action::HIT));
+    }
+  });
+
+  DecisionCache::Stats stats = cache.stats();
+  EXPECT_EQ(stats.hits + stats.misses, 400u);
+  EXPECT_EQ(cache.size(), 17u);
+}
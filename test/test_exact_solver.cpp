@@ -0,0 +1,54 @@
+#include <gtest/gtest.h>
+
+#include "exact_solver.h"
+#include "test_util.h"
+
+TEST(ExactSolverTest, TestBasicDecisions) {
+  ExactSolver solver;
+  Shoe shoe = fullShoe(4);
+
+  ActionValues twenty = solver.evaluate(handOf({10, 10}), 6, shoe);
+  EXPECT_GT(twenty.stand, twenty.hit);
+  EXPECT_GT(twenty.stand, twenty.doubleDown);
+
+  ActionValues eleven = solver.evaluate(handOf({5, 6}), 6, shoe);
+  EXPECT_GT(eleven.doubleDown, eleven.hit);
+  EXPECT_GT(eleven.hit, eleven.stand);
+
+  ActionValues sixteen = solver.evaluate(handOf({10, 6}), 10, shoe);
+  EXPECT_LT(sixteen.stand, 0);
+  EXPECT_DOUBLE_EQ(sixteen.surrender, -0.5);
+}
+
+TEST(ExactSolverTest, TestSpecialPayouts) {
+  ExactSolver solver;
+
+  // 6-7 之後牌靴只剩 8，要牌一定成順子賠 2 倍
+  Shoe onlyEights;
+  onlyEights.add(8, 4);
+  EXPECT_DOUBLE_EQ(solver.hit(handOf({6, 7}), 10, onlyEights), 2);
+
+  // 四張牌 8 點，再拿一張 2 就是五張牌查理
+  Shoe twos;
+  twos.add(2, 8);
+  EXPECT_DOUBLE_EQ(solver.hit(handOf({2, 2, 2, 2}), 10, twos), 2);
+
+  // 玩家黑傑克遇到莊家爆牌只賠 1 倍
+  Shoe bust;
+  bust.add(6);
+  bust.add(10, 3);
+  double blackjack = solver.stand(handOf({1, 10}), 10, bust);
+  EXPECT_GT(blackjack, 0);
+  EXPECT_LE(blackjack, 1.5);
+}
+
+TEST(ExactSolverTest, TestInsurance) {
+  ExactSolver solver;
+
+  Shoe tens;
+  tens.add(10, 3);
+  tens.add(5, 1);
+  EXPECT_DOUBLE_EQ(solver.insurance(1, tens), 0.75 - 0.25 * 0.5);
+  EXPECT_LT(solver.insurance(1, fullShoe(4)), 0);
+  EXPECT_DOUBLE_EQ(solver.insurance(10, tens), -0.5);
+}
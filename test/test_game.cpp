@@ -0,0 +1,66 @@
+#include <gtest/gtest.h>
+
+#include <stdexcept>
+
+#include "game.h"
+
+TEST(GameTest, TestSimulateIsDeterministic) {
+  GameConfig config;
+  config.seed = 2024;
+
+  SimulationResult first = Game::simulate(config, 6, 3);
+  SimulationResult second = Game::simulate(config, 6, 3);
+
+  EXPECT_EQ(first.games, 6);
+  EXPECT_EQ(first.wins + first.losses + first.draws, first.games);
+
+  // 每個分片的結果只跟種子有關，合併順序固定
+  EXPECT_EQ(first.wins, second.wins);
+  EXPECT_EQ(first.losses, second.losses);
+  EXPECT_EQ(first.draws, second.draws);
+  EXPECT_EQ(first.profit, second.profit);
+}
+
+TEST(GameTest, TestTablesAreIndependent) {
+  GameConfig config;
+  config.leastBet = 500;
+  config.decks = 6;
+
+  Game first(config);
+  Game second;
+
+  EXPECT_EQ(first.getTable().leastBet, 500);
+  EXPECT_EQ(first.getTable().decks, 6);
+  EXPECT_EQ(second.getLeasetBet(), 1000);
+}
+
+TEST(GameTest, TestSimulateIsHeadless) {
+  GameConfig config;
+  config.seed = 7;
+
+  testing::internal::CaptureStdout();
+  Game::simulate(config, 2, 1);
+  std::string output = testing::internal::GetCapturedStdout();
+
+  EXPECT_TRUE(output.empty());
+}
+
+TEST(GameTest, TestSimulateWithStrategyTable) {
+  // 全部停牌的表，AI 座位只查表不搜尋，也不會用到決策快取
+  std::string path = testing::TempDir() + "game_strategy_table.bin";
+  StrategyTable(4, 0, 1).save(path);
+
+  GameConfig config;
+  config.seed = 2024;
+  config.strategyTable = path;
+
+  SimulationResult result = Game::simulate(config, 6, 2);
+  EXPECT_EQ(result.games, 6);
+  EXPECT_EQ(result.wins + result.losses + result.draws, result.games);
+  EXPECT_EQ(result.cacheHits + result.cacheMisses, 0);
+
+  // 表的副數跟牌桌不一樣時拒絕開啟
+  config.decks = 6;
+  EXPECT_THROW(Game::simulate(config, 6, 2), std::runtime_error);
+  EXPECT_THROW(Game game(config), std::runtime_error);
+}
@@ -0,0 +1,56 @@
+#include <gtest/gtest.h>
+
+#include "hand_state.h"
+
+TEST(HandStateTest, TestTotal) {
+  HandState hand;
+  hand.add(Poker(spade, "A"));
+  EXPECT_EQ(hand.total(), 11);
+  EXPECT_TRUE(hand.isSoft());
+
+  hand.add(Poker(spade, "6"));
+  EXPECT_EQ(hand.total(), 17);
+  EXPECT_TRUE(hand.dealerShouldHit());  // 軟17要繼續抽
+
+  hand.add(Poker(heart, "9"));
+  EXPECT_EQ(hand.total(), 16);
+  EXPECT_FALSE(hand.isSoft());
+
+  hand.add(Poker(heart, "K"));
+  EXPECT_TRUE(hand.isBust());
+  EXPECT_EQ(hand.total(), 26);
+
+  HandState hard17;
+  hard17.add(Poker(spade, "10"));
+  hard17.add(Poker(spade, "7"));
+  EXPECT_FALSE(hard17.dealerShouldHit());
+}
+
+TEST(HandStateTest, TestSpecialHands) {
+  HandState blackjack;
+  blackjack.add(Poker(spade, "A"));
+  blackjack.add(Poker(spade, "Q"));
+  EXPECT_TRUE(blackjack.isBlackjack());
+  blackjack.add(Poker(spade, "A"));
+  EXPECT_FALSE(blackjack.isBlackjack());
+
+  HandState shun;
+  shun.add(Poker(spade, "7"));
+  shun.add(Poker(heart, "8"));
+  shun.add(Poker(club, "6"));
+  EXPECT_TRUE(shun.isShun());
+  EXPECT_EQ(shun.total(), 21);
+
+  HandState charlie;
+  for (int i = 0; i < 4; i++) charlie.add(Poker(spade, "2"));
+  EXPECT_FALSE(charlie.isFiveCardCharlie());
+  charlie.add(Poker(spade, "K"));
+  EXPECT_TRUE(charlie.isFiveCardCharlie());
+  EXPECT_FALSE(charlie.isShun());
+
+  // 蓋著的牌不計入
+  std::vector<Poker> pokers = {Poker(spade, "K"), Poker(heart, "A")};
+  pokers[1].flipTheCard();
+  EXPECT_EQ(HandState::of(pokers).total(), 10);
+  EXPECT_EQ(HandState::of(pokers).cardCount, 1);
+}
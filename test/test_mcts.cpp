@@ -0,0 +1,419 @@
+#include <gtest/gtest.h>
+
+#include "default_operation.h"
+#include "mcts.h"
+#include "test_util.h"
+
+namespace {
+
+mcts::Config testConfig() {
+  mcts::Config config;
+  config.playoutsPerLeaf = 200;
+  config.seed = 2024;
+  return config;
+}
+
+}  // namespace
+
+TEST(MCTSTest, TestStandOnTwenty) {
+  std::vector<Poker> pokers = {Poker(spade, "K"), Poker(heart, "Q")};
+  std::vector<Poker> dealerVisibleCards = {Poker(club, "6")};
+
+  mcts::MCTS engine(300, pokers, deckCards(4), dealerVisibleCards,
+                    testConfig());
+  const mcts::Node& best = engine.run();
+
+  EXPECT_EQ(best.action, mcts::Action::STAND);
+}
+
+TEST(MCTSTest, TestTreeLinks) {
+  std::vector<Poker> pokers = {Poker(spade, "5"), Poker(heart, "6")};
+  std::vector<Poker> dealerVisibleCards = {Poker(club, "A")};
+
+  mcts::MCTS engine(300, pokers, deckCards(4), dealerVisibleCards,
+                    testConfig());
+  engine.run();
+
+  const mcts::Node& root = engine.node(engine.root);
+  EXPECT_EQ(root.parent, mcts::NO_NODE);
+  // 莊家明牌是 A，根節點五個動作都可以選
+  for (int i = 0; i < MAX_CHILDREN; i++) {
+    mcts::NodeId child = root.children[i];
+    ASSERT_NE(child, mcts::NO_NODE);
+    EXPECT_EQ(engine.node(child).parent, engine.root);
+  }
+  EXPECT_TRUE(engine.node(root.children[mcts::Action::HIT]).chance);
+
+  std::uint32_t childVisits = 0;
+  for (mcts::NodeId id = 1; id < engine.nodeCount(); id++) {
+    const mcts::Node& node = engine.node(id);
+    if (node.parent == engine.root) childVisits += node.visits;
+    // 只有機會節點底下的子節點會增加抽牌數，保險會一路傳下去
+    const mcts::Node& parent = engine.node(node.parent);
+    EXPECT_EQ(node.drawCount, parent.drawCount + (parent.chance ? 1 : 0));
+    EXPECT_EQ(node.chance,
+              !parent.chance && node.action == mcts::Action::HIT);
+    if (parent.chance) {
+      EXPECT_EQ(parent.children[node.point - 1], id);
+    } else {
+      EXPECT_EQ(node.point, 0);
+    }
+    EXPECT_EQ(node.insured,
+              parent.insured || node.action == mcts::Action::INSURANCE);
+  }
+  EXPECT_EQ(childVisits, root.visits);
+}
+
+TEST(MCTSTest, TestAdvanceKeepsSubtree) {
+  std::vector<Poker> pokers = {Poker(spade, "5"), Poker(heart, "6")};
+  std::vector<Poker> dealerVisibleCards = {Poker(club, "9")};
+
+  mcts::MCTS engine(300, pokers, deckCards(4), dealerVisibleCards,
+                    testConfig());
+  engine.run();
+
+  mcts::NodeId hitChild = engine.node(engine.root).children[mcts::Action::HIT];
+  mcts::NodeId fourChild = engine.node(hitChild).children[4 - 1];
+  ASSERT_NE(fourChild, mcts::NO_NODE);
+  std::uint32_t fourVisits = engine.node(fourChild).visits;
+
+  // 拿到 4 之後只沿用抽到 4 的那棵子樹
+  engine.advance(Poker(diamond, "4"));
+  EXPECT_EQ(engine.root, fourChild);
+  EXPECT_EQ(engine.node(engine.root).parent, mcts::NO_NODE);
+  EXPECT_EQ(engine.node(engine.root).visits, fourVisits);
+  EXPECT_EQ(engine.node(engine.root).point, 4);
+
+  // 要過牌之後不能再加倍、投降或買保險
+  engine.run(100);
+  mcts::ActionTable table = engine.actionTable();
+  EXPECT_TRUE(table[mcts::Action::HIT].available);
+  EXPECT_TRUE(table[mcts::Action::STAND].available);
+  EXPECT_FALSE(table[mcts::Action::DOUBLE].available);
+  EXPECT_FALSE(table[mcts::Action::SURRENDER].available);
+  EXPECT_FALSE(table[mcts::Action::INSURANCE].available);
+
+  mcts::Action best = engine.bestAction({mcts::Action::HIT, mcts::Action::STAND,
+                                         mcts::Action::DOUBLE});
+  EXPECT_NE(best, mcts::Action::DOUBLE);
+}
+
+TEST(MCTSTest, TestEarlyStoppingOnCloseHand) {
+  // 硬 16 對 10：要牌(約 0.276)只比停牌(約 0.272)好一點，
+  // 信賴區間不應該在錯的動作上分開
+  std::vector<Poker> hard16 = {Poker(spade, "10"), Poker(heart, "6")};
+  std::vector<Poker> dealerVisibleCards = {Poker(club, "K")};
+
+  mcts::SearchLimits limits;
+  limits.iterations = 15000;
+  limits.confidence = 0.95;
+
+  for (std::uint64_t seed = 1; seed <= 10; seed++) {
+    mcts::Config config = testConfig();
+    config.seed = seed;
+    mcts::MCTS engine(1, hard16, deckCards(4), dealerVisibleCards, config);
+    mcts::SearchResult result = engine.search(limits);
+    if (result.stats.stopReason == StopReason::CONFIDENCE) {
+      EXPECT_EQ(result.best, mcts::Action::HIT) << "seed " << seed;
+    }
+  }
+}
+
+TEST(MCTSTest, TestChanceNodes) {
+  // 硬 5 點對 10 一定要牌，要牌的機會節點會被訪問很多次
+  std::vector<Poker> pokers = {Poker(spade, "2"), Poker(heart, "3")};
+  std::vector<Poker> dealerVisibleCards = {Poker(club, "K")};
+
+  mcts::MCTS engine(2000, pokers, deckCards(4), dealerVisibleCards,
+                    testConfig());
+  engine.run();
+
+  mcts::NodeId hitChild = engine.node(engine.root).children[mcts::Action::HIT];
+  const mcts::Node& chance = engine.node(hitChild);
+  ASSERT_TRUE(chance.chance);
+
+  // 看不到的牌：四副牌扣掉 2、3 和莊家的 K
+  Shoe unseen = Shoe::of(deckCards(4));
+  unseen.remove(2);
+  unseen.remove(3);
+  unseen.remove(10);
+
+  // 每種牌被選到的次數跟抽到的機率成比例(隨機抽樣的誤差會大上好幾倍)，
+  // 機會節點的價值是子節點依機率加權的平均
+  std::uint32_t outcomeVisits = 0;
+  double expected = 0;
+  for (int point = 1; point <= MAX_OUTCOMES; point++) {
+    mcts::NodeId child = chance.children[point - 1];
+    ASSERT_NE(child, mcts::NO_NODE);
+    const mcts::Node& outcome = engine.node(child);
+    EXPECT_EQ(outcome.point, point);
+    EXPECT_EQ(outcome.drawCount, 1);
+    outcomeVisits += outcome.visits;
+
+    double p = static_cast<double>(unseen.count(point)) / unseen.size();
+    EXPECT_NEAR(outcome.visits, p * chance.visits, 4.0);
+    expected += p * outcome.value / outcome.visits;
+  }
+  // 第一次訪問機會節點時還沒有展開，直接模擬
+  EXPECT_EQ(outcomeVisits + 1, chance.visits);
+  EXPECT_NEAR(chance.value / chance.visits, expected, 0.02);
+}
+
+TEST(MCTSTest, TestParallelModes) {
+  std::vector<Poker> pokers = {Poker(spade, "K"), Poker(heart, "Q")};
+  std::vector<Poker> dealerVisibleCards = {Poker(club, "6")};
+
+  for (mcts::ParallelMode mode :
+       {mcts::ParallelMode::LEAF, mcts::ParallelMode::TREE,
+        mcts::ParallelMode::ROOT}) {
+    mcts::Config config = testConfig();
+    config.parallel = mode;
+    config.threads = 4;
+
+    mcts::MCTS engine(300, pokers, deckCards(4), dealerVisibleCards, config);
+    const mcts::Node& best = engine.run();
+    EXPECT_EQ(best.action, mcts::Action::STAND);
+
+    const mcts::Node& root = engine.node(engine.root);
+    EXPECT_EQ(root.visits, 300u);
+    // 搜尋結束後不應該留下 virtual loss
+    for (mcts::NodeId id = 0; id < engine.nodeCount(); id++) {
+      EXPECT_EQ(engine.node(id).virtualLoss, 0u);
+    }
+  }
+
+  // 葉平行和根平行在多執行緒下也只跟種子有關
+  for (mcts::ParallelMode mode :
+       {mcts::ParallelMode::LEAF, mcts::ParallelMode::ROOT}) {
+    mcts::Config config = testConfig();
+    config.parallel = mode;
+    config.threads = 4;
+
+    mcts::MCTS first(300, pokers, deckCards(4), dealerVisibleCards, config);
+    mcts::MCTS second(300, pokers, deckCards(4), dealerVisibleCards, config);
+    first.run();
+    second.run();
+
+    mcts::ActionTable a = first.actionTable();
+    mcts::ActionTable b = second.actionTable();
+    for (std::size_t i = 0; i < a.size(); i++) {
+      EXPECT_EQ(a[i].visits, b[i].visits);
+      EXPECT_EQ(a[i].value, b[i].value);
+    }
+  }
+}
+
+TEST(MCTSTest, TestSearchStats) {
+  std::vector<Poker> pokers = {Poker(spade, "5"), Poker(heart, "6")};
+  std::vector<Poker> dealerVisibleCards = {Poker(club, "9")};
+
+  for (mcts::ParallelMode mode :
+       {mcts::ParallelMode::LEAF, mcts::ParallelMode::TREE,
+        mcts::ParallelMode::ROOT}) {
+    mcts::Config config = testConfig();
+    config.parallel = mode;
+    config.threads = 2;
+
+    mcts::MCTS engine(200, pokers, deckCards(4), dealerVisibleCards, config);
+    engine.run();
+
+    const SearchStats& stats = engine.stats();
+    EXPECT_EQ(stats.iterations, 200u);
+    EXPECT_GT(stats.nodesAllocated, 0u);
+    EXPECT_GE(stats.maxDepth, 1u);
+    // 終局節點直接用平均值，不一定每次迭代都模擬
+    EXPECT_GT(stats.playouts, 0u);
+    EXPECT_LE(stats.playouts, 200u * config.playoutsPerLeaf);
+    EXPECT_EQ(stats.playouts % config.playoutsPerLeaf, 0u);
+    EXPECT_GT(stats.playoutNs, 0u);
+    EXPECT_GT(stats.wallNs, 0u);
+    if (mode != mcts::ParallelMode::ROOT) {
+      EXPECT_EQ(stats.nodesAllocated, engine.nodeCount() - 1);
+    }
+
+    // 再跑一次只算新的這一次
+    engine.run(50);
+    EXPECT_EQ(engine.stats().iterations, 50u);
+  }
+
+  SearchStats stats;
+  stats.iterations = 3;
+  stats.maxDepth = 2;
+  EXPECT_NE(stats.toJson().find("\"iterations\":3,"), std::string::npos);
+  EXPECT_NE(stats.toJson().find("\"maxDepth\":2,"), std::string::npos);
+}
+
+TEST(MCTSTest, TestSearchLimits) {
+  std::vector<Poker> pokers = {Poker(spade, "5"), Poker(heart, "6")};
+  std::vector<Poker> dealerVisibleCards = {Poker(club, "9")};
+
+  // 時間到就停，迭代次數不會跑完
+  mcts::MCTS timed(1, pokers, deckCards(4), dealerVisibleCards, testConfig());
+  mcts::SearchLimits deadline;
+  deadline.iterations = 1000000;
+  deadline.timeLimit = std::chrono::milliseconds(20);
+  mcts::SearchResult result = timed.search(deadline);
+  EXPECT_GT(result.stats.iterations, 0u);
+  EXPECT_LT(result.stats.iterations, 1000000u);
+  EXPECT_LT(result.stats.wallNs, 500000000u);
+  EXPECT_EQ(result.best, timed.bestAction({mcts::Action::HIT,
+                                           mcts::Action::STAND,
+                                           mcts::Action::DOUBLE,
+                                           mcts::Action::SURRENDER}));
+  EXPECT_TRUE(result.actions[result.best].available);
+
+  // 模擬次數剛好用完預算
+  mcts::MCTS playouts(1, pokers, deckCards(4), dealerVisibleCards,
+                      testConfig());
+  mcts::SearchLimits playoutBudget;
+  playoutBudget.playouts = 10 * testConfig().playoutsPerLeaf;
+  EXPECT_EQ(playouts.search(playoutBudget).stats.playouts,
+            playoutBudget.playouts);
+
+  // 新建的節點不會超過預算
+  mcts::MCTS nodes(1, pokers, deckCards(4), dealerVisibleCards, testConfig());
+  mcts::SearchLimits nodeBudget;
+  nodeBudget.nodes = 100;
+  EXPECT_LE(nodes.search(nodeBudget).stats.nodesAllocated, 100u);
+
+  // 什麼都不設定時跑建構時給的次數，0 次就不搜尋
+  mcts::MCTS fallback(30, pokers, deckCards(4), dealerVisibleCards,
+                      testConfig());
+  EXPECT_EQ(fallback.search(mcts::SearchLimits()).stats.iterations, 30u);
+  fallback.run(0);
+  EXPECT_EQ(fallback.stats().iterations, 0u);
+}
+
+TEST(MCTSTest, TestEarlyStopping) {
+  std::vector<Poker> hard20 = {Poker(spade, "K"), Poker(heart, "Q")};
+  std::vector<Poker> dealerVisibleCards = {Poker(club, "6")};
+
+  mcts::SearchLimits limits;
+  limits.iterations = 5000;
+  limits.confidence = 0.95;
+
+  // 硬 20 點明顯要停牌，不用跑完 5000 次
+  mcts::MCTS obvious(5000, hard20, deckCards(4), dealerVisibleCards,
+                     testConfig());
+  mcts::SearchResult result = obvious.search(limits);
+  EXPECT_EQ(result.stats.stopReason, StopReason::CONFIDENCE);
+  EXPECT_EQ(result.best, mcts::Action::STAND);
+  EXPECT_LT(result.stats.iterations, 1000u);
+
+  // 信心水準要求越高，停得越晚
+  mcts::MCTS strict(5000, hard20, deckCards(4), dealerVisibleCards,
+                    testConfig());
+  limits.confidence = 0.999999;
+  EXPECT_GE(strict.search(limits).stats.iterations, result.stats.iterations);
+
+  // 不開提早停止就跑完全部
+  mcts::MCTS full(5000, hard20, deckCards(4), dealerVisibleCards,
+                  testConfig());
+  limits.confidence = 0;
+  mcts::SearchResult fullResult = full.search(limits);
+  EXPECT_EQ(fullResult.stats.iterations, 5000u);
+  EXPECT_EQ(fullResult.stats.stopReason, StopReason::ITERATIONS);
+  EXPECT_NE(fullResult.stats.toJson().find("\"stopReason\":\"iterations\""),
+            std::string::npos);
+}
+
+TEST(MCTSTest, TestRolloutPolicies) {
+  Xoshiro256 rng(2024);
+  HandState hard12;
+  hard12.addPoint(10);
+  hard12.addPoint(2);
+
+  mcts::FixedCountPolicy twice(2);
+  EXPECT_TRUE(twice.hit(hard12, 10, 0, rng));
+  EXPECT_TRUE(twice.hit(hard12, 10, 1, rng));
+  EXPECT_FALSE(twice.hit(hard12, 10, 2, rng));
+  EXPECT_FALSE(mcts::FixedCountPolicy().hit(hard12, 10, 0, rng));
+
+  HandState twentyOne;
+  twentyOne.addPoint(1);
+  twentyOne.addPoint(10);
+  EXPECT_FALSE(mcts::RandomPolicy(1.0).hit(twentyOne, 10, 0, rng));
+  EXPECT_TRUE(mcts::RandomPolicy(1.0).hit(hard12, 10, 0, rng));
+  EXPECT_FALSE(mcts::RandomPolicy(0.0).hit(hard12, 10, 0, rng));
+
+  // 基本策略跟 DefaultOperation 的要牌規則一樣
+  DefaultOperation operation;
+  Shoe unseen;
+  TableContext table{1000, 4};
+  const mcts::BasicStrategyPolicy& basic = mcts::BasicStrategyPolicy::shared();
+  for (int first = 1; first <= 10; first++) {
+    for (int second = 1; second <= 10; second++) {
+      for (int upcard = 1; upcard <= 13; upcard++) {
+        std::vector<Poker> hand = {Poker(spade, first), Poker(heart, second)};
+        std::vector<Poker> dealer = {Poker(club, upcard)};
+        DecisionContext context{hand, dealer, unseen, 5000, table};
+        EXPECT_EQ(basic.hit(HandState::of(hand), RANK_POINT[upcard], 0, rng),
+                  operation.hit(context));
+      }
+    }
+  }
+
+  // 硬 5 點對 10 直接停牌幾乎一定輸，照基本策略繼續要牌的估計比較接近實際價值
+  std::vector<Poker> hard5 = {Poker(spade, "2"), Poker(heart, "3")};
+  std::vector<Poker> dealerVisibleCards = {Poker(club, "K")};
+  mcts::Config standConfig = testConfig();
+  mcts::FixedCountPolicy stand;
+  standConfig.rollout = &stand;
+  mcts::MCTS standing(1, hard5, deckCards(4), dealerVisibleCards, standConfig);
+  mcts::MCTS playing(1, hard5, deckCards(4), dealerVisibleCards, testConfig());
+  EXPECT_GT(playing.playout(playing.root),
+            standing.playout(standing.root) + 0.05);
+}
+
+TEST(MCTSTest, TestVarianceReduction) {
+  // 莊家明牌 10，牌靴只剩 7 到 A：不管底牌是什麼莊家都不用再抽牌，
+  // 硬 20 停牌的結果只跟底牌有關
+  std::vector<Poker> hard20 = {Poker(spade, "K"), Poker(heart, "Q")};
+  std::vector<Poker> dealerVisibleCards = {Poker(club, "K")};
+  Shoe unseen;
+  unseen.add(1, 3);
+  unseen.add(7, 5);
+  unseen.add(8, 6);
+  unseen.add(9, 7);
+  unseen.add(10, 11);
+
+  mcts::Config exact = testConfig();
+  mcts::MCTS exactSearch(1, HandState::of(hard20), unseen, dealerVisibleCards,
+                         exact);
+  double expected = exactSearch.playout(exactSearch.root);
+
+  // 底牌分層之後每一層的結果都一樣，估計值沒有誤差
+  for (std::uint64_t seed : {1, 2, 3}) {
+    mcts::Config config = testConfig();
+    config.exactDealer = false;
+    config.seed = seed;
+    mcts::MCTS search(1, HandState::of(hard20), unseen, dealerVisibleCards,
+                      config);
+    EXPECT_NEAR(search.playout(search.root), expected, 1e-9);
+  }
+
+  // 隨機抽底牌有誤差，不同種子的結果不一樣
+  mcts::Config random = testConfig();
+  random.exactDealer = false;
+  random.stratifiedHoleCard = false;
+  random.seed = 1;
+  mcts::MCTS first(1, HandState::of(hard20), unseen, dealerVisibleCards,
+                   random);
+  random.seed = 2;
+  mcts::MCTS second(1, HandState::of(hard20), unseen, dealerVisibleCards,
+                    random);
+  EXPECT_NE(first.playout(first.root), second.playout(second.root));
+
+  // 對偶抽樣不會改變期望值
+  std::vector<Poker> hard12 = {Poker(spade, "10"), Poker(heart, "2")};
+  mcts::Config exactConfig = testConfig();
+  exactConfig.playoutsPerLeaf = 4000;
+  mcts::MCTS reference(1, hard12, deckCards(4), dealerVisibleCards,
+                       exactConfig);
+  mcts::Config antithetic = exactConfig;
+  antithetic.exactDealer = false;
+  antithetic.antitheticDraws = true;
+  mcts::MCTS paired(1, hard12, deckCards(4), dealerVisibleCards, antithetic);
+  EXPECT_NEAR(paired.playout(paired.root), reference.playout(reference.root),
+              0.02);
+}
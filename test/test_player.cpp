@@ -7,21 +7,12 @@
 
 class MockOperation : public Operation {  // Just for inject mock operation
   public:
-    std::map<std::string, bool> doubleOrSurrender(std::vector<Poker>,
-                                                  std::vector<Poker>,
-                                                  std::vector<Poker>) override {
-      return {{"double", false}, {"surrender", false}};
-    }
-    bool hit(std::vector<Poker>, std::vector<Poker>, std::vector<Poker>) override {
-      return false;
-    }
-    bool insurance(std::vector<Poker>, std::vector<Poker>,
-                  std::vector<Poker>) override {
-      return false;
-    }
-    int stake(int, std::vector<Poker>, std::vector<Poker>) override {
-      return 0;
+    OpeningDecision doubleOrSurrender(const DecisionContext&) override {
+      return OpeningDecision::NOTHING;
     }
+    bool hit(const DecisionContext&) override { return false; }
+    bool insurance(const DecisionContext&) override { return false; }
+    int stake(const DecisionContext&) override { return 0; }
 };
 
 TEST(PlayerTest, TestPlayer) {
@@ -0,0 +1,39 @@
+#include <gtest/gtest.h>
+
+#include "poker.h"
+
+TEST(PokerTest, TestEncoding) {
+  EXPECT_EQ(sizeof(Poker), 1);
+
+  Poker pokerA(heart, "A");
+  EXPECT_EQ(pokerA.getRank(), Poker::ACE);
+  EXPECT_EQ(pokerA.getSuit(), heart);
+  EXPECT_EQ(pokerA.getNumber(), "A");
+  EXPECT_TRUE(pokerA.isFaceUp());
+
+  Poker poker10(club, "10");
+  EXPECT_EQ(poker10.getRank(), 10);
+  EXPECT_EQ(poker10.getNumber(), "10");
+  EXPECT_EQ(Poker(diamond, Poker::QUEEN).getNumber(), "Q");
+
+  // 翻面不影響點數和花色
+  poker10.flipTheCard();
+  EXPECT_FALSE(poker10.isFaceUp());
+  EXPECT_EQ(poker10.getRank(), 10);
+  EXPECT_EQ(poker10.getSuit(), club);
+  EXPECT_EQ(poker10, Poker(club, 10));
+  EXPECT_NE(poker10, Poker(spade, 10));
+}
+
+TEST(PokerTest, TestPattern) {
+  Poker poker(spade, "10");
+  EXPECT_EQ(poker.getPattern().size(), 22);
+  EXPECT_EQ(poker.getPattern()[1], "|10             |");
+  EXPECT_EQ(Poker(heart, "K").getPattern()[20], "|              K|");
+
+  // 同樣的牌共用同一份圖案
+  EXPECT_EQ(&Poker(spade, "10").getPattern(), &poker.getPattern());
+
+  poker.flipTheCard();
+  EXPECT_EQ(poker.getPattern()[1], "|***************|");
+}
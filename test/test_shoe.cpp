@@ -0,0 +1,110 @@
+#include <gtest/gtest.h>
+
+#include <random>
+
+#include "rng.h"
+#include "shoe.h"
+
+TEST(ShoeTest, TestCounts) {
+  std::vector<Poker> pokers = {Poker(spade, "A"), Poker(heart, "A"),
+                               Poker(spade, "10"), Poker(club, "J"),
+                               Poker(diamond, "K"), Poker(spade, "5")};
+  Shoe shoe = Shoe::of(pokers);
+
+  EXPECT_EQ(shoe.size(), 6);
+  EXPECT_EQ(shoe.count(1), 2);
+  EXPECT_EQ(shoe.count(10), 3);
+  EXPECT_EQ(shoe.count(5), 1);
+  EXPECT_EQ(shoe.count(9), 0);
+
+  shoe.remove(Poker(club, "Q"));
+  EXPECT_EQ(shoe.count(10), 2);
+  EXPECT_EQ(shoe.size(), 5);
+}
+
+TEST(ShoeTest, TestDrawWithoutReplacement) {
+  std::mt19937 rng(42);
+  Shoe shoe;
+  shoe.add(1, 3);
+  shoe.add(7, 2);
+  shoe.add(10, 5);
+
+  int drawn[Shoe::POINTS + 1] = {};
+  while (!shoe.empty()) drawn[shoe.draw(rng)]++;
+
+  EXPECT_EQ(drawn[1], 3);
+  EXPECT_EQ(drawn[7], 2);
+  EXPECT_EQ(drawn[10], 5);
+  EXPECT_EQ(shoe, Shoe());
+}
+
+TEST(ShoeTest, TestDrawAt) {
+  Shoe shoe;
+  shoe.add(1, 3);
+  shoe.add(7, 2);
+  shoe.add(10, 5);
+
+  // 牌依牌值排好：0-2 是 A，3-4 是 7，5-9 是 10 點牌
+  Shoe copy = shoe;
+  EXPECT_EQ(copy.drawAt(0), 1);
+  EXPECT_EQ(copy.drawAt(2), 7);
+  EXPECT_EQ(copy.drawAt(7), 10);
+  EXPECT_EQ(copy.size(), 7);
+  EXPECT_EQ(copy.count(1), 2);
+  EXPECT_EQ(copy.count(7), 1);
+  EXPECT_EQ(copy.count(10), 4);
+
+  copy = shoe;
+  EXPECT_EQ(copy.drawAt(4), 7);
+  copy = shoe;
+  EXPECT_EQ(copy.drawAt(9), 10);
+}
+
+TEST(ShoeTest, TestDrawIsWeighted) {
+  std::mt19937 rng(7);
+  Shoe shoe;
+  shoe.add(2, 1);
+  shoe.add(10, 9);
+
+  int tens = 0;
+  const int trials = 10000;
+  for (int i = 0; i < trials; i++) {
+    Shoe copy = shoe;
+    if (copy.draw(rng) == 10) tens++;
+  }
+  EXPECT_NEAR(static_cast<double>(tens) / trials, 0.9, 0.02);
+}
+
+TEST(ShoeTest, TestDrawIsReproducible) {
+  Shoe shoe;
+  for (int point = 1; point <= Shoe::POINTS; point++) shoe.add(point, 16);
+
+  Xoshiro256 rng1 = Xoshiro256::forStream(2024, 3);
+  Xoshiro256 rng2 = Xoshiro256::forStream(2024, 3);
+  Xoshiro256 other = Xoshiro256::forStream(2024, 4);
+  Shoe shoe1 = shoe, shoe2 = shoe, shoe3 = shoe;
+
+  bool differs = false;
+  for (int i = 0; i < 50; i++) {
+    int point = shoe1.draw(rng1);
+    EXPECT_EQ(point, shoe2.draw(rng2));
+    if (point != shoe3.draw(other)) differs = true;
+  }
+  EXPECT_TRUE(differs);
+}
+
+TEST(ShoeTest, TestOfCardSpan) {
+  std::vector<Poker> pokers = {Poker(spade, "A"), Poker(heart, "9"),
+                               Poker(club, "K"), Poker(diamond, "2")};
+
+  // 只看中間兩張，不複製原本的牌
+  CardSpan middle(pokers.data() + 1, 2);
+  Shoe shoe = Shoe::of(middle);
+
+  EXPECT_EQ(middle.front(), pokers[1]);
+  EXPECT_EQ(middle.back(), pokers[2]);
+  EXPECT_EQ(shoe.size(), 2);
+  EXPECT_EQ(shoe.count(9), 1);
+  EXPECT_EQ(shoe.count(10), 1);
+  EXPECT_EQ(shoe.count(1), 0);
+}
@@ -0,0 +1,144 @@
+#include <gtest/gtest.h>
+
+#include <fstream>
+#include <stdexcept>
+
+#include "exact_operation.h"
+#include "strategy_table.h"
+#include "strategy_table_generator.h"
+#include "table_operation.h"
+#include "test_util.h"
+
+TEST(StrategyTableTest, TestSaveAndMap) {
+  std::string path = testing::TempDir() + "strategy_table_test.bin";
+
+  StrategyTable built(4, -2, 5);
+  HandState hard16 = handOf({10, 6});
+  HandState soft18 = handOf({1, 7});
+  built.set(built.indexOf(hard16, 10, 2),
+            StrategyTable::HIT | StrategyTable::SURRENDER);
+  built.set(built.indexOf(soft18, 6, 2), StrategyTable::DOUBLE);
+  built.save(path);
+
+  StrategyTable mapped(path);
+  EXPECT_EQ(mapped.header().version, StrategyTable::VERSION);
+  EXPECT_EQ(mapped.header().decks, 4);
+  EXPECT_EQ(mapped.header().minCount, -2);
+  EXPECT_EQ(mapped.header().countBuckets, 5);
+  EXPECT_EQ(mapped.size(), 5 * StrategyTable::STATES_PER_BUCKET);
+
+  // 整副牌的真數是 0，在第 2 個 bucket
+  Shoe shoe = fullShoe(4);
+  EXPECT_EQ(mapped.countBucketOf(shoe), 2);
+  EXPECT_EQ(mapped.lookup(hard16, 10, shoe),
+            StrategyTable::HIT | StrategyTable::SURRENDER);
+  EXPECT_EQ(mapped.lookup(soft18, 6, shoe), StrategyTable::DOUBLE);
+  EXPECT_EQ(mapped.lookup(hard16, 9, shoe), 0);
+}
+
+TEST(StrategyTableTest, TestCountBuckets) {
+  StrategyTable table(1, -2, 5);
+
+  // 拿掉 10 張低牌：running count +10，剩 42 張，真數約 +12，取最大的 bucket
+  Shoe lowDepleted = fullShoe(1);
+  for (int i = 0; i < 10; i++) lowDepleted.remove(2 + i % 5);
+  EXPECT_EQ(table.countBucketOf(lowDepleted), 4);
+
+  // 拿掉一張 10 點牌：真數約 -1
+  Shoe oneTenGone = fullShoe(1);
+  oneTenGone.remove(10);
+  EXPECT_EQ(table.countBucketOf(oneTenGone), 1);
+
+  // 只有一個 bucket 時不看牌靴
+  StrategyTable flat(1, 0, 1);
+  EXPECT_EQ(flat.countBucketOf(lowDepleted), 0);
+}
+
+TEST(StrategyTableTest, TestRejectsInvalidFile) {
+  std::string path = testing::TempDir() + "strategy_table_invalid.bin";
+  std::ofstream(path, std::ios::binary) << "not a strategy table";
+
+  EXPECT_THROW(StrategyTable table(path), std::runtime_error);
+  EXPECT_THROW(StrategyTable table(path + ".missing"), std::runtime_error);
+
+  // 副數不一樣的表
+  std::string sixDecks = testing::TempDir() + "strategy_table_six_decks.bin";
+  StrategyTable(6, 0, 1).save(sixDecks);
+  EXPECT_THROW(StrategyTable table(sixDecks, 4), std::runtime_error);
+  EXPECT_EQ(StrategyTable(sixDecks, 6).header().decks, 6);
+  EXPECT_EQ(StrategyTable(sixDecks).header().decks, 6);
+}
+
+TEST(StrategyTableTest, TestTableOperation) {
+  StrategyTable table(4, 0, 1);
+  table.set(table.indexOf(handOf({10, 6}), 10, 0),
+            StrategyTable::HIT | StrategyTable::SURRENDER);
+  table.set(table.indexOf(handOf({9, 2}), 6, 0),
+            StrategyTable::HIT | StrategyTable::DOUBLE);
+  table.set(table.indexOf(handOf({10, 10}), 1, 0), StrategyTable::INSURANCE);
+
+  TableOperation operation(table);
+  Shoe unseen = fullShoe(4);
+  TableContext tableContext{1000, 4};
+  std::vector<Poker> ten = {Poker(spade, "K")};
+  std::vector<Poker> six = {Poker(spade, "6")};
+  std::vector<Poker> ace = {Poker(spade, "A")};
+
+  std::vector<Poker> hard16 = {Poker(heart, "10"), Poker(club, "6")};
+  DecisionContext against10{hard16, ten, unseen, 5000, tableContext};
+  EXPECT_EQ(operation.doubleOrSurrender(against10),
+            OpeningDecision::SURRENDER);
+  EXPECT_TRUE(operation.hit(against10));
+  EXPECT_EQ(operation.stake(against10), 1000);
+
+  std::vector<Poker> hard11 = {Poker(heart, "9"), Poker(club, "2")};
+  DecisionContext against6{hard11, six, unseen, 5000, tableContext};
+  EXPECT_EQ(operation.doubleOrSurrender(against6), OpeningDecision::DOUBLE);
+
+  std::vector<Poker> hard20 = {Poker(heart, "Q"), Poker(club, "J")};
+  DecisionContext againstAce{hard20, ace, unseen, 5000, tableContext};
+  EXPECT_TRUE(operation.insurance(againstAce));
+  EXPECT_FALSE(operation.hit(againstAce));
+}
+
+TEST(StrategyTableTest, TestGeneratedTableMatchesExactOperation) {
+  StrategyTable table(4, 0, 1);
+  StrategyTableGenerator::fill(table);
+
+  // 只有一個 bucket，查表時不看牌靴
+  Shoe shoe = fullShoe(4);
+  EXPECT_EQ(table.lookup(handOf({10, 6}), 10, shoe),
+            StrategyTable::HIT | StrategyTable::SURRENDER);
+  EXPECT_TRUE(table.lookup(handOf({9, 2}), 6, shoe) & StrategyTable::DOUBLE);
+
+  // 查表和 ExactOperation 在產生表時用的牌靴上要做一樣的選擇
+  TableOperation tableOperation(table);
+  ExactOperation exactOperation;
+  TableContext tableContext{1000, 4};
+
+  std::vector<Poker> ten = {Poker(spade, "K")};
+  std::vector<Poker> hard16 = {Poker(heart, "10"), Poker(club, "6")};
+  Shoe unseen16 = StrategyTableGenerator::shoeFor(4, 0, {10, 6}, 10);
+  DecisionContext against10{hard16, ten, unseen16, 5000, tableContext};
+  EXPECT_EQ(tableOperation.doubleOrSurrender(against10),
+            OpeningDecision::SURRENDER);
+  EXPECT_EQ(exactOperation.doubleOrSurrender(against10),
+            OpeningDecision::SURRENDER);
+  EXPECT_EQ(tableOperation.hit(against10), exactOperation.hit(against10));
+
+  std::vector<Poker> six = {Poker(spade, "6")};
+  std::vector<Poker> hard11 = {Poker(heart, "9"), Poker(club, "2")};
+  Shoe unseen11 = StrategyTableGenerator::shoeFor(4, 0, {9, 2}, 6);
+  DecisionContext against6{hard11, six, unseen11, 5000, tableContext};
+  EXPECT_EQ(tableOperation.doubleOrSurrender(against6),
+            OpeningDecision::DOUBLE);
+  EXPECT_EQ(exactOperation.doubleOrSurrender(against6),
+            OpeningDecision::DOUBLE);
+
+  // 產生的牌靴真數要落在對應的 bucket
+  StrategyTable counted(4, -4, 9);
+  for (int trueCount = -4; trueCount <= 4; trueCount++) {
+    Shoe shoe = StrategyTableGenerator::shoeFor(4, trueCount, {10, 6}, 10);
+    EXPECT_EQ(counted.countBucketOf(shoe), trueCount + 4) << trueCount;
+  }
+}
@@ -0,0 +1,77 @@
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <stdexcept>
+#include <string>
+
+#include "thread_pool.h"
+
+TEST(ThreadPoolTest, TestSharedPoolIsReused) {
+  ThreadPool& pool = ThreadPool::shared();
+
+  EXPECT_EQ(&pool, &ThreadPool::shared());
+  EXPECT_GT(pool.size(), 0u);
+}
+
+TEST(ThreadPoolTest, TestPinnedPoolRunsTasks) {
+  ThreadPool pool(2, true);
+  std::atomic<int> sum(0);
+
+  std::vector<std::future<void>> results;
+  for (int i = 1; i <= 100; i++) {
+    results.push_back(pool.enqueue([&sum, i] { sum += i; }));
+  }
+  for (auto& future : results) future.get();
+
+  EXPECT_EQ(pool.size(), 2u);
+  EXPECT_EQ(sum, 5050);
+}
+
+TEST(ThreadPoolTest, TestParallelForVisitsEachIndexOnce) {
+  ThreadPool pool(3);
+  std::vector<std::atomic<int>> hits(1000);
+
+  pool.parallel_for(0, hits.size(), 7, [&](size_t i) { hits[i]++; });
+
+  for (auto& hit : hits) EXPECT_EQ(hit, 1);
+}
+
+TEST(ThreadPoolTest, TestParallelReduceIsOrdered) {
+  ThreadPool pool(4);
+
+  // 字串相加不可交換，結果必須依照索引順序合併
+  std::string result = pool.parallel_reduce(
+      0, 26, 3, std::string(),
+      [](size_t i) { return std::string(1, static_cast<char>('a' + i)); },
+      [](const std::string& a, const std::string& b) { return a + b; });
+
+  EXPECT_EQ(result, "abcdefghijklmnopqrstuvwxyz");
+}
+
+TEST(ThreadPoolTest, TestNestedTaskGroupOnSingleWorker) {
+  // 只有一條工作線程，外層任務等內層任務時必須自己幫忙跑
+  ThreadPool pool(1);
+  std::atomic<int> sum(0);
+
+  TaskGroup outer(pool);
+  for (int i = 0; i < 4; i++) {
+    outer.run([&pool, &sum] {
+      TaskGroup inner(pool);
+      for (int j = 0; j < 4; j++) inner.run([&sum] { sum++; });
+      inner.wait();
+    });
+  }
+  outer.wait();
+
+  EXPECT_EQ(sum, 16);
+}
+
+TEST(ThreadPoolTest, TestTaskGroupRethrows) {
+  ThreadPool pool(2);
+  TaskGroup group(pool);
+
+  group.run([] { throw std::runtime_error("playout failed"); });
+  group.run([] {});
+
+  EXPECT_THROW(group.wait(), std::runtime_error);
+}
@@ -0,0 +1,40 @@
+#ifndef TEST_UTIL_H
+#define TEST_UTIL_H
+#include <initializer_list>
+#include <vector>
+
+#include "hand_state.h"
+#include "poker.h"
+#include "shoe.h"
+
+// 測試和 benchmark 共用的牌組
+
+// decks 副完整的牌，依花色和點數排好
+inline std::vector<Poker> deckCards(int decks = 4) {
+  std::vector<Poker> cardPool;
+  for (int deck = 0; deck < decks; deck++) {
+    for (int i = 0; i < 4; i++) {
+      for (int j = 1; j <= 13; j++) {
+        cardPool.push_back(Poker(static_cast<Suit>(i), j));
+      }
+    }
+  }
+  return cardPool;
+}
+
+// decks 副完整的牌的組成
+inline Shoe fullShoe(int decks = 4) {
+  Shoe shoe;
+  for (int point = 1; point <= 9; point++) shoe.add(point, 4 * decks);
+  shoe.add(10, 16 * decks);
+  return shoe;
+}
+
+// 依序拿到 points 這些牌值的手牌
+inline HandState handOf(std::initializer_list<int> points) {
+  HandState hand;
+  for (int point : points) hand.addPoint(point);
+  return hand;
+}
+
+#endif
@@ -0,0 +1,36 @@
+// 產生 TableOperation 用的策略表：
+//   generate_strategy_table [輸出檔] [幾副牌] [最大真數]
+// 每個(玩家手牌, 莊家明牌, 真數)狀態用 ExactSolver 算出每個動作的期望值，
+// 不同的(真數, 明牌)分給執行緒池平行計算。
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+
+#include "strategy_table.h"
+#include "strategy_table_generator.h"
+
+int main(int argc, char* argv[]) {
+  std::string output = argc > 1 ? argv[1] : "strategy_table.bin";
+  int decks = argc > 2 ? std::atoi(argv[2]) : 4;
+  int maxCount = argc > 3 ? std::atoi(argv[3]) : 4;
+
+  if (decks < 1 || maxCount < 0 || maxCount > 100) {
+    std::cerr << "usage: " << argv[0]
+              << " [output] [decks >= 1] [max true count 0-100]\n";
+    return 1;
+  }
+
+  StrategyTable table(decks, -maxCount, 2 * maxCount + 1);
+  auto start = std::chrono::steady_clock::now();
+  std::size_t states = StrategyTableGenerator::fill(table);
+
+  table.save(output);
+
+  double seconds = std::chrono::duration<double>(
+                       std::chrono::steady_clock::now() - start)
+                       .count();
+  std::cout << "wrote " << states << " states (" << table.size() << " entries) to " << output
+            << " in " << seconds << "s" << std::endl;
+  return 0;
+}